@@ -0,0 +1,27 @@
+#if !defined BENCH_BENCH_HPP
+#define BENCH_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace bench
+{
+
+/** @brief Run the function the given number of times and print the mean duration of a call */
+void run_case(std::string_view name, std::size_t iterations, const std::function<void()>& fn);
+
+/** @brief Run all the date parsing benchmark cases */
+void run_date_cases();
+
+/** @brief Prevent the compiler from optimizing away the computation of the value */
+template <typename ValueType>
+void keep(const ValueType& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace bench
+
+#endif // !defined BENCH_BENCH_HPP
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_exception.hpp"
+#include "common/date.hpp"
+#include "bench/bench.hpp"
+
+namespace
+{
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 14)
+# define BENCH_HAS_CHRONO_PARSE 0
+#else
+# define BENCH_HAS_CHRONO_PARSE 1
+#endif
+
+#if BENCH_HAS_CHRONO_PARSE
+/** @brief The former, stream based convert_date implementation (the baseline) */
+std::chrono::year_month_day convert_date_stream(const std::string& raw)
+{
+    std::chrono::year_month_day result;
+
+    std::istringstream is{raw};
+    is >> std::chrono::parse("%F", result);
+
+    if (is.fail())
+    {
+        throw common::common_exception(
+            common::common_exception::error_code::data_format_error,
+            fmt::format("The birth date has unexpected format: '{}'", raw));
+    }
+
+    return result;
+}
+#endif // BENCH_HAS_CHRONO_PARSE
+
+std::vector<std::string> generate_dates(std::size_t count)
+{
+    std::vector<std::string> result;
+    result.reserve(count);
+
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        result.emplace_back(
+            fmt::format("{:04}-{:02}-{:02}", 1800 + idx % 220, 1 + idx % 12, 1 + idx % 28));
+    }
+
+    return result;
+}
+
+} // anonymous namespace
+
+namespace bench
+{
+
+void run_date_cases()
+{
+    constexpr std::size_t k_iterations = 100;
+    const std::vector<std::string> dates = generate_dates(10000);
+
+#if BENCH_HAS_CHRONO_PARSE
+    for (const std::string& date : dates)
+    {
+        if (common::convert_date(date) != common::partial_date(convert_date_stream(date)))
+        {
+            throw std::logic_error(fmt::format("The date parsers disagree on '{}'", date));
+        }
+    }
+
+    run_case(
+        "convert_date (std::chrono::parse)", k_iterations,
+        [&dates]() {
+            for (const std::string& date : dates)
+            {
+                keep(convert_date_stream(date));
+            }
+        });
+#endif // BENCH_HAS_CHRONO_PARSE
+
+    run_case(
+        "convert_date (parse_iso_date)", k_iterations,
+        [&dates]() {
+            for (const std::string& date : dates)
+            {
+                keep(common::convert_date(date));
+            }
+        });
+}
+
+} // namespace bench
@@ -0,0 +1,34 @@
+#include <chrono>
+#include <iostream>
+
+#include <fmt/format.h>
+
+#include "bench/bench.hpp"
+
+namespace bench
+{
+
+void run_case(std::string_view name, std::size_t iterations, const std::function<void()>& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t idx = 0; idx < iterations; ++idx)
+    {
+        fn();
+    }
+
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << fmt::format(
+        "{:<40} {:>12.1f} ns/call ({} calls)\n", name, elapsed.count() / iterations, iterations);
+}
+
+} // namespace bench
+
+int main()
+{
+    bench::run_date_cases();
+
+    return 0;
+}
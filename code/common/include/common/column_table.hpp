@@ -0,0 +1,188 @@
+#if !defined COMMON_COLUMN_TABLE_HPP
+#define COMMON_COLUMN_TABLE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <redland.h>
+
+#include "common/redland_utils.hpp"
+#include "common/typed_literal.hpp"
+
+namespace common
+{
+
+/** @brief Append only storage of the string values with stable addresses
+ *
+ *  The values are copied into large blocks, so storing a value doesn't allocate unless the current
+ *   block is exhausted. The views returned by the store function stay valid as long as the arena
+ *   exists (also after the arena is moved). */
+class string_arena
+{
+public:
+    static constexpr std::size_t k_default_block_size = 16 * 1024;
+
+    explicit string_arena(std::size_t block_size = k_default_block_size)
+        : m_block_size(block_size) {}
+
+    string_arena(const string_arena&) = delete;
+    string_arena& operator=(const string_arena&) = delete;
+
+    /** @brief Take over the blocks of the other arena (left empty, but still usable) */
+    string_arena(string_arena&& other) noexcept
+        : m_blocks(std::move(other.m_blocks)), m_block_size(other.m_block_size),
+          m_block_used(std::exchange(other.m_block_used, 0)),
+          m_block_free(std::exchange(other.m_block_free, 0)),
+          m_capacity(std::exchange(other.m_capacity, 0))
+    {
+        other.m_blocks.clear();
+    }
+
+    string_arena& operator=(string_arena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_blocks = std::move(other.m_blocks);
+            other.m_blocks.clear();
+            m_block_size = other.m_block_size;
+            m_block_used = std::exchange(other.m_block_used, 0);
+            m_block_free = std::exchange(other.m_block_free, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+        }
+
+        return *this;
+    }
+
+    /** @brief Copy the value into the arena and return the view of the copy */
+    std::string_view store(std::string_view value);
+
+    /** @brief Get the total size of the allocated blocks */
+    [[nodiscard]] std::size_t get_capacity() const { return m_capacity; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    std::size_t m_block_size;
+    std::size_t m_block_used { 0 };
+    std::size_t m_block_free { 0 };
+    std::size_t m_capacity { 0 };
+};
+
+/** @brief Query result table stored column wise
+ *
+ *  The table is the allocation-lean counterpart of the extract_data_table_result. The binding
+ *   names are stored once, in the table head, and the cells are the views of the values copied
+ *   into the table arena. A column is addressed by its index, which can be looked up once (see
+ *   get_column_req) and used for all the rows, so no string keyed lookup is done per cell.
+ *
+ *  Appending a row allocates only when the column vectors or the current arena block need to
+ *   grow, i.e. the allocation count is amortized constant instead of a few per cell. */
+class column_table
+{
+public:
+    using column_index = std::size_t;
+
+    column_table() = default;
+    explicit column_table(head_row head);
+
+    column_table(const column_table&) = delete;
+    column_table& operator=(const column_table&) = delete;
+    column_table(column_table&&) noexcept = default;
+    column_table& operator=(column_table&&) noexcept = default;
+
+    [[nodiscard]] const head_row& get_head() const { return m_head; }
+    [[nodiscard]] std::size_t get_column_count() const { return m_head.size(); }
+    [[nodiscard]] std::size_t get_row_count() const { return m_row_count; }
+    [[nodiscard]] bool empty() const { return (m_row_count == 0); }
+
+    /** @brief Find the index of the named column (nullopt if there's no such column) */
+    [[nodiscard]] std::optional<column_index> find_column(std::string_view binding_name) const;
+
+    /** @brief Get the index of the named column
+     *
+     *  @throws common_exception (binding_not_found) when there's no such column */
+    [[nodiscard]] column_index get_column_req(std::string_view binding_name) const;
+
+    /** @brief Get the cell value (nullopt if the variable isn't bound in the row) */
+    [[nodiscard]] std::optional<std::string_view> get(std::size_t row, column_index column) const
+    {
+        return m_columns[column][row];
+    }
+
+    /** @brief Get the datatype uri of the typed literal cell (empty for the other cells) */
+    [[nodiscard]] std::string_view get_datatype(std::size_t row, column_index column) const
+    {
+        return m_datatype_columns[column][row];
+    }
+
+    /** @brief Get the cell value converted according to its datatype (see convert_literal)
+     *
+     *  @return nullopt if the variable isn't bound in the row
+     *
+     *  @throws common_exception (data_format_error) when the lexical form is invalid */
+    [[nodiscard]] std::optional<typed_cell> get_typed(
+        std::size_t row, column_index column,
+        const literal_converter_lut& lut = get_default_literal_converters()) const;
+
+    /** @brief Get all the cells of the column */
+    [[nodiscard]] std::span<const std::optional<std::string_view>> get_column(
+        column_index column) const
+    {
+        return m_columns[column];
+    }
+
+    /** @brief Get the cell value
+     *
+     *  @throws common_exception (binding_not_found) when the variable isn't bound in the row */
+    [[nodiscard]] std::string_view get_req(std::size_t row, column_index column) const;
+
+    /** @brief Append the row of the column count values (copied into the table arena)
+     *
+     *  @param datatypes the datatype uris of the values (empty or of the column count size)
+     *
+     *  @throws common_exception (input_contract_error) on the value count mismatch */
+    void append_row(
+        std::span<const std::optional<std::string_view>> values,
+        std::span<const std::string_view> datatypes = {});
+
+    /** @brief Append the current row of the query results (see append_row above)
+     *
+     *  The values are assumed to follow the table head order. */
+    void append_row(const query_row_view& row);
+
+    /** @brief Convert the table to the map based representation (for the legacy consumers) */
+    [[nodiscard]] data_table to_data_table() const;
+
+private:
+    /** @brief Store the datatype uri in the arena unless it's already stored */
+    std::string_view intern_datatype(std::string_view datatype);
+
+    head_row m_head;
+    std::vector<std::vector<std::optional<std::string_view>>> m_columns;
+    std::vector<std::vector<std::string_view>> m_datatype_columns;
+    /** The distinct datatype uris stored in the arena (usually just a few of them) */
+    std::vector<std::string_view> m_datatypes;
+    std::size_t m_row_count { 0 };
+    string_arena m_arena;
+};
+
+/** @brief Extract the query results into the column table
+ *
+ *  @throws common_exception (redland_unexpected_behavior) on an unexpected node type */
+column_table extract_column_table(librdf_query_results* results);
+
+/** @brief Extract the values of the column into the string sequence
+ *
+ *  @throws common_exception (binding_not_found) when there's no such column (in a non-empty table)
+ *      or the variable isn't bound in a row */
+std::vector<std::string> extract_resource_uri_seq(
+    const column_table& table, std::string_view binding_name);
+
+} // namespace common
+
+#endif // !defined COMMON_COLUMN_TABLE_HPP
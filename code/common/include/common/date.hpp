@@ -0,0 +1,71 @@
+#if !defined COMMON_DATE_HPP
+#define COMMON_DATE_HPP
+
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace common
+{
+
+/** @brief Calendar date of the year, the month or the day precision
+ *
+ *  The GEDCOM-X data carries the partial dates (e.g. only the birth year is known), which the
+ *   std::chrono::year_month_day can't represent. The day is only specified together with the
+ *   month. */
+struct partial_date
+{
+    partial_date() = default;
+    explicit partial_date(std::chrono::year y) : year(y) {}
+    partial_date(std::chrono::year y, std::chrono::month m) : year(y), month(m) {}
+    partial_date(const std::chrono::year_month_day& ymd)
+        : year(ymd.year()), month(ymd.month()), day(ymd.day()) {}
+
+    [[nodiscard]] bool is_complete() const { return day.has_value(); }
+
+    /** @brief Get the complete date (nullopt if the date is partial) */
+    [[nodiscard]] std::optional<std::chrono::year_month_day> get_complete() const;
+
+    bool operator==(const partial_date&) const = default;
+
+    std::chrono::year year;
+    std::optional<std::chrono::month> month;
+    std::optional<std::chrono::day> day;
+};
+
+/** @brief Format the date as YYYY, YYYY-MM or YYYY-MM-DD (depending on the precision)
+ *
+ *  The year has at least four digits, the same as the std::format %Y specifier produces. */
+[[nodiscard]] std::string to_string(const partial_date& date);
+
+inline std::ostream& operator<<(std::ostream& os, const partial_date& date)
+{
+    os << to_string(date);
+    return os;
+}
+
+/** @brief Parse the ISO-8601 calendar date of the YYYY, YYYY-MM or YYYY-MM-DD form
+ *
+ *  The validation follows the std::chrono::parse("%F") function semantics the parser replaces:
+ *   the year has up to four digits and an optional sign, the month and the day have one or two
+ *   digits and the text following a complete date (e.g. a time or a timezone) is ignored unless
+ *   it starts with a digit. The year and the year-month forms have to span the whole input.
+ *
+ *  The parser is shared by the data_row dates (see convert_date) and the xsd:date literals of the
+ *   typed query results (see convert_literal), so both yield the same dates.
+ *
+ *  No allocation is made and no stream or locale is involved.
+ *
+ *  @return nullopt when the input isn't a valid date (also when the date doesn't exist) */
+[[nodiscard]] std::optional<partial_date> parse_iso_date(std::string_view raw) noexcept;
+
+/** @brief Convert the date literal into the (possibly partial) date
+ *
+ *  @throws common_exception (data_format_error) when the literal isn't a valid date */
+partial_date convert_date(std::string_view raw);
+
+} // namespace common
+
+#endif // !defined COMMON_DATE_HPP
@@ -0,0 +1,68 @@
+#if !defined COMMON_FILE_FINGERPRINT_HPP
+#define COMMON_FILE_FINGERPRINT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace common
+{
+
+/** @brief Calculate the 64-bit FNV-1a hash of the data
+ *
+ *  The hash is stable between runs and platforms, so it can be persisted (unlike std::hash). It is
+ *   not a cryptographic hash and must not be used to detect deliberate modifications. */
+std::uint64_t hash_bytes(std::string_view data);
+
+struct file_fingerprint
+{
+    std::uint64_t size { 0 };
+    /** The last write time as the file clock tick count */
+    std::int64_t mtime { 0 };
+    std::uint64_t content_hash { 0 };
+
+    bool operator==(const file_fingerprint& other) const = default;
+};
+
+/** @brief Get the file size and the last write time without reading the file content
+ *
+ *  The content_hash member of the result is left zeroed.
+ *
+ *  @throws common_exception (general_runtime_error) when the file status can't be retrieved */
+file_fingerprint stat_file(const std::filesystem::path& file_path);
+
+/** @brief Get the file size, the last write time and the content hash
+ *
+ *  @throws common_exception (general_runtime_error) when the file can't be accessed or read */
+file_fingerprint fingerprint_file(const std::filesystem::path& file_path);
+
+/** @brief Check if the file still matches the recorded fingerprint
+ *
+ *  The file is considered unchanged when its size and last write time match the fingerprint. When
+ *   only the last write time differs, the content hash decides (and the @p fingerprint is updated
+ *   then, so the next check doesn't have to read the file again).
+ *
+ *  @throws common_exception (general_runtime_error) when the file can't be accessed or read */
+bool is_file_unchanged(const std::filesystem::path& file_path, file_fingerprint& fingerprint);
+
+enum class write_outcome : std::uint8_t
+{
+    written,
+    unchanged
+};
+
+/** @brief Write the content into the file unless the file already has the very content
+ *
+ *  The existing file is compared by its size first and byte by byte then, so the unchanged
+ *   file is left untouched (its last write time is preserved and the make targets depending on it
+ *   aren't rebuilt). The changed file is replaced atomically (written to a temporary file which is
+ *   renamed then), so the readers never observe a partially written file. The parent directory is
+ *   created when missing.
+ *
+ *  @throws common_exception (general_runtime_error) when the file can't be read or written */
+write_outcome write_file_if_changed(
+    const std::filesystem::path& file_path, std::string_view content);
+
+} // namespace common
+
+#endif // !defined COMMON_FILE_FINGERPRINT_HPP
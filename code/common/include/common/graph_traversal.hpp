@@ -0,0 +1,55 @@
+#if !defined COMMON_GRAPH_TRAVERSAL_HPP
+#define COMMON_GRAPH_TRAVERSAL_HPP
+
+#include <functional>
+#include <optional>
+#include <string_view>
+
+#include <redland.h>
+
+#include "common/rdf_term.hpp"
+
+namespace common
+{
+
+/** @brief Statement pattern matched by the find_triples function
+ *
+ *  An empty position matches any term. */
+struct rdf_triple_pattern
+{
+    std::optional<rdf_term> subject;
+    std::optional<rdf_term> predicate;
+    std::optional<rdf_term> object;
+};
+
+/** @brief Construct the uri term */
+rdf_term make_uri_term(std::string_view uri);
+
+/** @brief Find the model statements matching the pattern
+ *
+ *  The statements are looked up directly in the model storage (librdf_model_find_statements),
+ *   which avoids the SPARQL query parsing, planning and the result table conversion.
+ *
+ *  @throws common_exception (redland_unexpected_behavior) when the pattern statement can't be
+ *      created or the lookup fails */
+rdf_triple_buffer find_triples(
+    librdf_world* world, librdf_model* model, const rdf_triple_pattern& pattern);
+
+/** @brief Callback receiving the statements matched by the visit_triples function */
+using triple_visitor = std::function<void(const rdf_triple& triple)>;
+
+/** @brief Pass the model statements matching the pattern to the visitor one by one
+ *
+ *  Unlike the find_triples function, the matching statements are never held in memory all at
+ *   once, which makes the function suitable for the whole model passes. An exception thrown by
+ *   the visitor is propagated to the caller.
+ *
+ *  @throws common_exception (redland_unexpected_behavior) when the pattern statement can't be
+ *      created or the lookup fails */
+void visit_triples(
+    librdf_world* world, librdf_model* model, const rdf_triple_pattern& pattern,
+    const triple_visitor& visitor);
+
+} // namespace common
+
+#endif // !defined COMMON_GRAPH_TRAVERSAL_HPP
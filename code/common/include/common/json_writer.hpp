@@ -0,0 +1,80 @@
+#if !defined COMMON_JSON_WRITER_HPP
+#define COMMON_JSON_WRITER_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace common
+{
+
+/** @brief Streaming JSON serializer writing the document as it's produced
+ *
+ *  The output is byte identical to the nlohmann::json::dump(indent) output of the equivalent
+ *   document (the negative indent selects the compact output, the same as for the dump
+ *   function), provided the object keys are written in the lexicographical order (the order of
+ *   the default nlohmann::json object). Unlike the dump function, the writer never holds the
+ *   whole document in memory: every value is written to the stream (which does the buffering)
+ *   right away.
+ *
+ *  The writer doesn't validate the document structure (e.g. a key written into an array), the
+ *   calls are expected to form a well formed document. The strings are expected to be UTF-8
+ *   encoded. */
+class json_writer
+{
+public:
+    static constexpr int k_default_indent = 4;
+    /** The indent selecting the compact output (no line breaks and no spaces) */
+    static constexpr int k_compact = -1;
+
+    explicit json_writer(std::ostream& os, int indent = k_default_indent)
+        : m_os(os), m_indent(indent) {}
+
+    json_writer(const json_writer&) = delete;
+    json_writer& operator=(const json_writer&) = delete;
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    /** @brief Write the key of the next member of the current object */
+    void key(std::string_view name);
+
+    void value(std::string_view text);
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(bool flag);
+    void value(std::int64_t number);
+    void null_value();
+
+    /** @brief Write the document subtree (for the rarely written, irregular parts) */
+    void embed(const nlohmann::json& subtree);
+
+    /** @brief Get the current nesting depth (0 outside of any object or array) */
+    [[nodiscard]] std::size_t get_depth() const { return m_frames.size(); }
+
+private:
+    struct frame
+    {
+        bool is_empty;
+    };
+
+    /** @brief Write the separator preceding the value (unless it follows a key) */
+    void begin_value();
+    void begin_container(char opening);
+    void end_container(char closing);
+    void write_line_break(std::size_t depth);
+    void write_string(std::string_view text);
+
+    std::ostream& m_os;
+    int m_indent;
+    std::vector<frame> m_frames;
+    bool m_after_key { false };
+};
+
+} // namespace common
+
+#endif // !defined COMMON_JSON_WRITER_HPP
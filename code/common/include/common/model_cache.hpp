@@ -0,0 +1,65 @@
+#if !defined COMMON_MODEL_CACHE_HPP
+#define COMMON_MODEL_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+
+#include <redland.h>
+
+#include "common/file_fingerprint.hpp"
+#include "common/file_system_utils.hpp"
+
+namespace common
+{
+
+struct input_manifest_entry
+{
+    file_fingerprint fingerprint;
+    std::uint64_t triple_count { 0 };
+};
+
+/** @brief The fingerprints of the input files stored in the cached model snapshot */
+using input_manifest = std::map<std::filesystem::path, input_manifest_entry>;
+
+/** @brief Get the path of the manifest accompanying the @p cache_path model snapshot */
+std::filesystem::path get_input_manifest_path(const std::filesystem::path& cache_path);
+
+/** @brief Read the input manifest
+ *
+ *  The manifest is a cache artifact, so a missing or malformed manifest is not an error. An empty
+ *   manifest is returned instead, which results in all the input files being re-parsed. */
+input_manifest read_input_manifest(const std::filesystem::path& manifest_path);
+
+/** @throws common_exception (general_runtime_error) on an output file operation failure */
+void write_input_manifest(
+    const std::filesystem::path& manifest_path, const input_manifest& manifest);
+
+/** @brief Load the input files into the model reusing the cached model snapshot
+ *
+ *  Only the new input files and the files whose fingerprints don't match the manifest are parsed.
+ *   The statements of the unchanged files are taken from the @p cache_path model snapshot and the
+ *   statements of the files no longer present in the input set are dropped. The snapshot and the
+ *   manifest are updated afterwards (unless nothing has changed).
+ *
+ *  A file is considered unchanged when its size and last write time match the manifest. When only
+ *   the last write time differs, the file content hash decides.
+ *
+ *  The statements of a file failed to parse are loaded up to the parse error (the same as by
+ *   load_rdf), but the file is left out of the snapshot and the manifest, so it's parsed again on
+ *   the next run.
+ *
+ *  @param thread_count the number of threads parsing the changed files (see load_rdf_set)
+ *
+ *  @throws common_exception (general_runtime_error) on a cache file operation failure
+ *  @throws common_exception (redland_initialization_failed) when a parsing context can't be
+ *      initialized
+ *  @throws common_exception (redland_unexpected_behavior) when a statement couldn't be added to
+ *      the model */
+void load_rdf_set_cached(
+    librdf_world* world, librdf_model* model, const input_files& input_file_paths,
+    unsigned int thread_count, const std::filesystem::path& cache_path);
+
+} // namespace common
+
+#endif // !defined COMMON_MODEL_CACHE_HPP
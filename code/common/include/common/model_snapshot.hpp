@@ -0,0 +1,128 @@
+#if !defined COMMON_MODEL_SNAPSHOT_HPP
+#define COMMON_MODEL_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <redland.h>
+
+#include "common/rdf_term.hpp"
+
+namespace common
+{
+
+/** @brief Identifier of a term stored in the model snapshot dictionary */
+using snapshot_term_id = std::uint32_t;
+
+/** @brief Build a dictionary encoded, binary model snapshot
+ *
+ *  The snapshot consists of the term dictionary, the list of source files and the encoded triples
+ *   grouped by their source files. Every distinct term is stored only once and the triples refer
+ *   to the terms by their identifiers.
+ *
+ *  @par File Layout
+ *      `header | term records | source records | triple records | string pool`
+ *
+ *  All the integers are stored in the native byte order. A snapshot is not portable between
+ *   platforms of different endianness (the header includes a byte order mark, so such a snapshot
+ *   is rejected rather than misinterpreted). */
+class model_snapshot_builder
+{
+public:
+    /** @brief Append the triples parsed from the @p source_path file
+     *
+     *  @throws common_exception (data_size_error) when the number of the distinct terms exceeds
+     *      the term identifier range */
+    void add_source(const std::filesystem::path& source_path, const rdf_triple_buffer& triples);
+
+    /** @brief Write the snapshot to the @p snapshot_path file
+     *
+     *  The snapshot is written to a temporary file first and renamed afterwards, so an existing
+     *   snapshot is never left partially overwritten.
+     *
+     *  @throws common_exception (general_runtime_error) on an output file operation failure */
+    void write(const std::filesystem::path& snapshot_path) const;
+
+    [[nodiscard]] std::size_t term_count() const { return m_terms.size(); }
+    [[nodiscard]] std::size_t triple_count() const { return m_triples.size(); }
+
+private:
+    struct encoded_triple
+    {
+        snapshot_term_id subject;
+        snapshot_term_id predicate;
+        snapshot_term_id object;
+    };
+
+    struct source
+    {
+        std::string path;
+        std::uint64_t first_triple;
+        std::uint64_t triple_count;
+    };
+
+    snapshot_term_id intern(const rdf_term& term);
+
+    std::unordered_map<rdf_term, snapshot_term_id, rdf_term_hash> m_term_ids;
+    std::vector<const rdf_term*> m_terms;
+    std::vector<encoded_triple> m_triples;
+    std::vector<source> m_sources;
+};
+
+/** @brief Read-only, memory-mapped model snapshot */
+struct model_snapshot
+{
+    int fd { -1 };
+    const std::byte* data { nullptr };
+    std::size_t size { 0 };
+};
+
+void release_model_snapshot(model_snapshot* snapshot);
+
+using scoped_model_snapshot = std::unique_ptr<model_snapshot, decltype(&release_model_snapshot)>;
+
+/** @brief Map the snapshot file into memory and validate its structure
+ *
+ *  @throws common_exception (general_runtime_error) when the file can't be opened or mapped
+ *  @throws common_exception (data_format_error) when the file isn't a valid model snapshot */
+scoped_model_snapshot open_model_snapshot(const std::filesystem::path& snapshot_path);
+
+[[nodiscard]] std::size_t get_snapshot_source_count(const model_snapshot& snapshot);
+[[nodiscard]] std::size_t get_snapshot_triple_count(const model_snapshot& snapshot);
+
+/** @throws common_exception (input_contract_error) when the @p source_idx is out of range */
+[[nodiscard]] std::filesystem::path get_snapshot_source_path(
+    const model_snapshot& snapshot, std::size_t source_idx);
+
+/** @brief Load all the snapshot triples into the model
+ *
+ *  @throws common_exception (data_format_error) on an invalid term reference
+ *  @throws common_exception (redland_unexpected_behavior) when a node or statement couldn't be
+ *      created or added to the model */
+void load_model_snapshot(librdf_world* world, librdf_model* model, const model_snapshot& snapshot);
+
+/** @brief Load the triples of a single snapshot source file into the model
+ *
+ *  @throws common_exception (input_contract_error) when the @p source_idx is out of range
+ *  @throws common_exception (data_format_error) on an invalid term reference
+ *  @throws common_exception (redland_unexpected_behavior) when a node or statement couldn't be
+ *      created or added to the model */
+void load_model_snapshot_source(
+    librdf_world* world, librdf_model* model, const model_snapshot& snapshot,
+    std::size_t source_idx);
+
+/** @brief Decode the triples of a single snapshot source file
+ *
+ *  @throws common_exception (input_contract_error) when the @p source_idx is out of range
+ *  @throws common_exception (data_format_error) on an invalid term reference */
+[[nodiscard]] rdf_triple_buffer read_model_snapshot_source(
+    const model_snapshot& snapshot, std::size_t source_idx);
+
+} // namespace common
+
+#endif // !defined COMMON_MODEL_SNAPSHOT_HPP
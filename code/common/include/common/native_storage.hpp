@@ -0,0 +1,27 @@
+#if !defined COMMON_NATIVE_STORAGE_HPP
+#define COMMON_NATIVE_STORAGE_HPP
+
+#include <redland.h>
+
+namespace common
+{
+
+/** @brief The name of the native storage factory (see librdf_new_storage) */
+inline constexpr const char* k_native_storage_name = "native";
+
+/** @brief Register the native storage factory in the Redland world
+ *
+ *  The native storage interns the statement nodes to 32-bit identifiers and keeps the encoded
+ *   statements in three sorted permutation arrays (SPO, POS and OSP). Any statement pattern is
+ *   resolved by a binary search over the permutation whose key prefix covers the bound pattern
+ *   nodes, whereas the Redland "memory" storage scans all the statements.
+ *
+ *  The added statements are buffered and merged into the permutation arrays by the first lookup
+ *   following the additions. The storage doesn't support contexts.
+ *
+ *  @throws common_exception (redland_initialization_failed) when the factory can't be registered */
+void register_native_storage(librdf_world* world);
+
+} // namespace common
+
+#endif // !defined COMMON_NATIVE_STORAGE_HPP
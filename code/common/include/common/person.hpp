@@ -1,7 +1,6 @@
 #if !defined COMMON_PERSON_HPP
 #define COMMON_PERSON_HPP
 
-#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -11,6 +10,8 @@
 #include <nlohmann/json.hpp>
 #include <redland.h>
 
+#include "common/date.hpp"
+#include "common/json_writer.hpp"
 #include "common/note.hpp"
 #include "common/redland_utils.hpp"
 #include "common/resource.hpp"
@@ -64,8 +65,8 @@ public:
     std::optional<Gender> gender;
     std::vector<std::string> given_names;
     std::vector<std::string> last_names;
-    std::optional<std::chrono::year_month_day> birth_date;
-    std::optional<std::chrono::year_month_day> death_date;
+    std::optional<partial_date> birth_date;
+    std::optional<partial_date> death_date;
 
     std::shared_ptr<Person> mother;
     std::shared_ptr<Person> father;
@@ -86,9 +87,23 @@ Gender extract_person_gender(
     const data_row& row, const std::string& gender_type_bn, std::vector<Note>& notes);
 void extract_person_names(Person& person, const data_table& table);
 
+/* The streamed query row (see visit_query_results) counterparts of the above functions */
+void extract_person_birth_date(
+    Person& person, const query_row_view& row, std::string_view date_bn);
+void extract_person_death_date(
+    Person& person, const query_row_view& row, std::string_view date_bn);
+Gender extract_person_gender(
+    const query_row_view& row, std::string_view gender_type_bn, std::vector<Note>& notes);
+
 nlohmann::json person_to_json(const Person& person);
 nlohmann::json person_list_to_json(const std::vector<std::shared_ptr<Person>>& person_list);
 
+/** @brief Write the person the same way the person_to_json(person).dump() call does
+ *
+ *  The person object is streamed (see json_writer), only the notes are converted to the JSON
+ *   document first. */
+void write_person_json(json_writer& writer, const Person& person);
+
 } // namespace common
 
 #endif // !defined COMMON_PERSON_HPP
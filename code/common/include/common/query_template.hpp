@@ -0,0 +1,96 @@
+#if !defined COMMON_QUERY_TEMPLATE_HPP
+#define COMMON_QUERY_TEMPLATE_HPP
+
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <redland.h>
+
+#include "common/column_table.hpp"
+#include "common/redland_utils.hpp"
+
+namespace common
+{
+
+/** @brief The IRI values of the query template parameters (keyed by the parameter names) */
+using query_bindings = std::map<std::string, std::string, std::less<>>;
+
+/** @brief SPARQL query template with IRI parameters
+ *
+ *  The parameters are denoted in the template by the `%{name}` placeholders. A placeholder is
+ *   replaced by the bound IRI enclosed in angle brackets, e.g. the `FILTER (?person = %{person})`
+ *   template fragment becomes `FILTER (?person = <http://example.org/P1>)`.
+ *
+ *  The template is validated and split into the text and the parameter segments on construction.
+ *   Binding produces a new query text, which is parsed and planned by Redland on every execution
+ *   (the same as the text passed to exec_query). */
+class query_template
+{
+public:
+    /** @throws common_exception (input_contract_error) on an unterminated or empty placeholder */
+    query_template(std::string query_id, std::string_view template_text);
+
+    [[nodiscard]] const std::string& get_id() const { return m_id; }
+
+    /** @brief Produce the query text with all the parameters replaced by the bound IRIs
+     *
+     *  @throws common_exception (input_contract_error) on a missing binding or a bound value
+     *      that isn't a valid IRI reference */
+    [[nodiscard]] std::string bind(const query_bindings& bindings) const;
+
+private:
+    struct segment
+    {
+        std::string text;
+        bool is_parameter;
+    };
+
+    std::string m_id;
+    std::vector<segment> m_segments;
+    std::size_t m_text_size;
+};
+
+/** @brief Check if the value can be used as the SPARQL IRIREF content
+ *
+ *  The check rejects the characters that would allow the value to end the IRI reference early and
+ *   inject arbitrary query text. */
+[[nodiscard]] bool is_valid_iri_ref(std::string_view iri);
+
+/** @brief Execute the SELECT query template with the given parameter bindings
+ *
+ *  @throws common_exception (input_contract_error) on invalid bindings (see query_template::bind)
+ *  @throws common_exception (redland_query_error) on query creation or execution failure */
+extract_data_table_result exec_templated_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings = {});
+
+/** @brief Execute the SELECT query template and extract the result into the column table
+ *
+ *  The function is the allocation-lean counterpart of the exec_templated_query function meant for
+ *   the frequently executed queries.
+ *
+ *  @throws common_exception (input_contract_error) on invalid bindings (see query_template::bind)
+ *  @throws common_exception (redland_query_error) on query creation or execution failure */
+column_table exec_templated_column_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings = {});
+
+/** @brief Execute the SELECT query template and stream the result rows to the visitor
+ *
+ *  The rows aren't materialized, so the function is suitable for the queries
+ *   whose results are processed once, e.g. the whole data set listings (see visit_query_results).
+ *
+ *  @return the number of the visited rows
+ *
+ *  @throws common_exception (input_contract_error) on invalid bindings (see query_template::bind)
+ *  @throws common_exception (redland_query_error) on query creation or execution failure */
+std::size_t visit_templated_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings, const query_row_visitor& visitor);
+
+} // namespace common
+
+#endif // !defined COMMON_QUERY_TEMPLATE_HPP
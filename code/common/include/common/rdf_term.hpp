@@ -0,0 +1,85 @@
+#if !defined COMMON_RDF_TERM_HPP
+#define COMMON_RDF_TERM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <redland.h>
+
+namespace common
+{
+
+/** @brief World independent representation of an RDF term
+ *
+ *  The Redland nodes are bound to the world that created them and can't be shared between
+ *   worlds. The rdf_term structure is used wherever the RDF data has to cross the world boundary
+ *   (e.g. when the data is parsed by a worker thread owning a separate world). */
+struct rdf_term
+{
+    enum class kind : std::uint8_t
+    {
+        uri = 0,
+        literal,
+        blank
+    };
+
+    kind type { kind::uri };
+    /** The uri string, the literal lexical form or the blank node identifier */
+    std::string value;
+    /** The literal datatype uri (empty for the uri and blank terms and for plain literals) */
+    std::string datatype;
+    /** The literal language tag (empty for the uri and blank terms and for untagged literals) */
+    std::string language;
+
+    bool operator==(const rdf_term& other) const = default;
+};
+
+/** @brief Hash function object allowing the rdf_term to be used as the unordered container key */
+struct rdf_term_hash
+{
+    std::size_t operator()(const rdf_term& term) const noexcept;
+};
+
+struct rdf_triple
+{
+    rdf_term subject;
+    rdf_term predicate;
+    rdf_term object;
+
+    bool operator==(const rdf_triple& other) const = default;
+};
+
+using rdf_triple_buffer = std::vector<rdf_triple>;
+
+/** @brief Convert the Redland node to the world independent term representation
+ *
+ *  @throws common_exception (input_contract_error) when the @p node is null
+ *  @throws common_exception (redland_unexpected_behavior) on an unexpected node type */
+rdf_term to_rdf_term(librdf_node* node);
+
+/** @brief Create a new Redland node representing the term in the specified world
+ *
+ *  The caller takes the ownership of the returned node.
+ *
+ *  @throws common_exception (redland_unexpected_behavior) when the node couldn't be created */
+librdf_node* new_librdf_node(librdf_world* world, const rdf_term& term);
+
+/** @brief Prefix the blank node identifier with the given scope
+ *
+ *  The blank node identifiers generated by the Redland parser are unique only within the world
+ *   owning the parser. The identifiers of blank nodes parsed in different worlds have to be
+ *   scoped before the nodes are merged into a single model. Non-blank terms are left untouched. */
+void scope_blank_node(rdf_term& term, std::string_view scope);
+
+/** @brief Add the buffered triples to the model
+ *
+ *  @throws common_exception (redland_unexpected_behavior) when any of the statements couldn't be
+ *      created or added to the model */
+void add_rdf_triples(librdf_world* world, librdf_model* model, const rdf_triple_buffer& triples);
+
+} // namespace common
+
+#endif // !defined COMMON_RDF_TERM_HPP
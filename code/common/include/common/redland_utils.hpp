@@ -1,13 +1,21 @@
 #if !defined COMMON_REDLAND_UTILS_HPP
 #define COMMON_REDLAND_UTILS_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <redland.h>
 #include <spdlog/spdlog.h>
 
 #include "common/file_system_utils.hpp"
+#include "common/rdf_term.hpp"
 
 namespace common
 {
@@ -22,17 +30,84 @@ void release_redland_ctx(redland_context* ctx);
 
 using scoped_redland_ctx = std::unique_ptr<redland_context, decltype(&release_redland_ctx)>;
 
+/** @brief The storage backing the redland context model */
+enum class storage_backend : std::uint8_t
+{
+    /** The Redland "memory" storage (an unindexed statement list) */
+    memory = 0,
+    /** The dictionary encoded storage with sorted permutation indexes (see native_storage.hpp) */
+    native
+};
+
 scoped_redland_ctx create_redland_ctx();
 /** Initialize a new Redland RDF Library context
  *
  * @throws common_exception when the context initialization fails. All Redland resources allocated
  *     before the failure are released automatically. */
-void initialize_redland_ctx(scoped_redland_ctx& ctx);
+void initialize_redland_ctx(
+    scoped_redland_ctx& ctx, storage_backend backend = storage_backend::memory);
 
+/** @brief Create the contexts holding the copies of the source model statements
+ *
+ *  The copies are meant for the concurrent read-only querying, as a Redland world can't be used by
+ *   several threads at the same time. The contexts are created by the calling thread (the world
+ *   construction isn't guaranteed to be thread safe), while each copy is filled in by the
+ *   fill_redland_ctx_copy function called by the thread that will use the context.
+ *
+ *  @throws common_exception when a context initialization fails */
+std::vector<scoped_redland_ctx> create_redland_ctx_copies(
+    std::size_t count, storage_backend backend = storage_backend::memory);
+
+/** @brief Add the statements (see find_triples) to the context created by create_redland_ctx_copies
+ *
+ *  @throws common_exception (redland_unexpected_behavior) when a statement can't be added */
+void fill_redland_ctx_copy(redland_context& ctx, const rdf_triple_buffer& triples);
 
 void load_rdf(librdf_world* world, librdf_model* model, const std::string& input_file_path);
 void load_rdf_set(librdf_world* world, librdf_model* model, const input_files& input_file_paths);
 
+/** @brief Load the input files into the model using a pool of parsing threads
+ *
+ *  Every worker thread owns a separate Redland world and parser and parses the files into its own
+ *   statement buffer. The buffers are merged into the @p model by the calling thread in the
+ *   input file order. The blank node identifiers are scoped by the input file path hash, so the
+ *   blank nodes parsed from different files never collide and the scope of a file doesn't depend
+ *   on the other files of the set (see load_rdf_set_cached).
+ *
+ *  @param thread_count the number of parsing threads. The value of 0 selects the number of
+ *      hardware threads. The value of 1 is equivalent to the sequential load_rdf_set overload.
+ *
+ *  @throws common_exception (redland_initialization_failed) when a worker context can't be
+ *      initialized
+ *  @throws common_exception (redland_unexpected_behavior) when the parsed statements can't be
+ *      added to the @p model */
+void load_rdf_set(
+    librdf_world* world, librdf_model* model, const input_files& input_file_paths,
+    unsigned int thread_count);
+
+/** @brief Callback receiving the statements parsed from a single input file
+ *
+ *  The @p complete flag is cleared when the file couldn't be opened or a parse error was reported
+ *   (the error is logged then). The @p triples hold the statements parsed before the error, which
+ *   must not be cached under the file fingerprint. */
+using parsed_rdf_file_cb = std::function<void(
+    std::size_t file_idx, const std::filesystem::path& file_path, rdf_triple_buffer&& triples,
+    bool complete)>;
+
+/** @brief Parse the input files concurrently into world independent statement buffers
+ *
+ *  The @p callback is invoked on the calling thread, once per input file, in the input file
+ *   order. An exception thrown by the callback stops the parsing and is propagated to the caller
+ *   after all the worker threads are joined.
+ *
+ *  @param thread_count the number of parsing threads (0 selects the number of hardware threads)
+ *
+ *  @throws common_exception (redland_initialization_failed) when a worker context can't be
+ *      initialized */
+void parse_rdf_set(
+    const input_files& input_file_paths, unsigned int thread_count,
+    const parsed_rdf_file_cb& callback);
+
 struct exec_query_ctx {
     librdf_query* query = nullptr;
     librdf_query_results* results = nullptr;
@@ -74,6 +149,66 @@ extract_data_table_result extract_data_table(librdf_query_results* results);
 extract_data_table_result extract_data_table(
     librdf_query_results* results, const extract_cb_lut& cb_lut);
 
+/** @brief Borrowed view of the current row of the query results
+ *
+ *  The names and the values point into the Redland nodes of the row and are valid only during the
+ *   query_row_visitor call the view is passed to. A value has to be copied if it's needed later.
+ */
+class query_row_view
+{
+public:
+    query_row_view(
+        std::span<const std::string_view> names,
+        std::span<const std::optional<std::string_view>> values,
+        std::span<const std::string_view> datatypes = {})
+        : m_names(names), m_values(values), m_datatypes(datatypes) {}
+
+    [[nodiscard]] std::size_t size() const { return m_names.size(); }
+    [[nodiscard]] std::string_view get_name(std::size_t idx) const { return m_names[idx]; }
+    /** @brief Get the value of the binding (nullopt if the variable isn't bound in the row) */
+    [[nodiscard]] std::optional<std::string_view> get_value(std::size_t idx) const
+    {
+        return m_values[idx];
+    }
+
+    /** @brief Get the datatype uri of the typed literal value (empty for the other values) */
+    [[nodiscard]] std::string_view get_datatype(std::size_t idx) const
+    {
+        return (idx < m_datatypes.size() ? m_datatypes[idx] : std::string_view());
+    }
+
+    /** @brief Find the index of the named binding (nullopt if missing) */
+    [[nodiscard]] std::optional<std::size_t> find_index(std::string_view binding_name) const;
+
+    /** @brief Find the value of the named binding (nullopt if missing or not bound) */
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view binding_name) const;
+
+    /** @brief Get the value of the named binding
+     *
+     *  @throws common_exception (binding_not_found) when the binding is missing or not bound */
+    [[nodiscard]] std::string_view get_req(std::string_view binding_name) const;
+
+private:
+    std::span<const std::string_view> m_names;
+    std::span<const std::optional<std::string_view>> m_values;
+    std::span<const std::string_view> m_datatypes;
+};
+
+using query_row_visitor = std::function<void(const query_row_view& row)>;
+
+/** @brief Pass the query result rows to the visitor one by one
+ *
+ *  Unlike the extract_data_table function, the function doesn't materialize the result table. The
+ *   row values are borrowed from the Redland nodes, so no per row allocation is needed apart from
+ *   the nodes themselves. The datatype uris of the typed literals are provided as well (see
+ *   typed_literal.hpp). An exception thrown by the visitor stops the iteration and is propagated
+ *   to the caller.
+ *
+ *  @return the number of the visited rows
+ *
+ *  @throws common_exception (redland_unexpected_behavior) on an unexpected node type */
+std::size_t visit_query_results(librdf_query_results* results, const query_row_visitor& visitor);
+
 bool extract_boolean_result(librdf_query_results* results);
 
 data_row::const_iterator get_binding_value_req(
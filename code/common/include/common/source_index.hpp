@@ -0,0 +1,77 @@
+#if !defined COMMON_SOURCE_INDEX_HPP
+#define COMMON_SOURCE_INDEX_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/file_system_utils.hpp"
+#include "common/model_snapshot.hpp"
+#include "common/rdf_term.hpp"
+
+namespace common
+{
+
+/** @brief Index of the source files describing the resources
+ *
+ *  The index records the provenance of the statements: a resource is described by a source file
+ *   when the file contains a statement of the resource subject (the same condition the
+ *   "ASK { <resource> ?predicate ?object }" query checks on the model of the single file). The
+ *   index is built while the input data is loaded, so no source file has to be parsed again to
+ *   find the files a resource depends on.
+ *
+ *  The source paths are stored once and the resources refer to them by their indices. */
+class source_index
+{
+public:
+    /** @brief Record the subjects of the statements parsed from the @p source_path file
+     *
+     *  The sources are expected to be added once each (e.g. in the input file order). */
+    void add_source(const std::filesystem::path& source_path, const rdf_triple_buffer& triples);
+
+    /** @brief Record the uri subjects of the source file statements (e.g. the cached ones) */
+    void add_source(
+        const std::filesystem::path& source_path, std::span<const std::string> subject_uris);
+
+    /** @brief Get the source files describing the resource (empty if there are none) */
+    [[nodiscard]] file_set get_sources(std::string_view resource_uri) const;
+
+    /** @brief Get the source files of all the resources described by any of the sources
+     *
+     *  The sorted resource uris are intersected with the (sorted) indexed subjects in a single
+     *   linear pass over both sequences, instead of a lookup per resource.
+     *
+     *  @return the source files keyed by the resource uri (the resources not described by any
+     *      source are omitted) */
+    [[nodiscard]] std::map<std::string, file_set, std::less<>> intersect(
+        std::vector<std::string> resource_uris) const;
+
+    [[nodiscard]] std::size_t get_source_count() const { return m_source_paths.size(); }
+    [[nodiscard]] std::size_t get_resource_count() const { return m_resource_sources.size(); }
+
+private:
+    using source_id = std::uint32_t;
+
+    source_id add_source_path(const std::filesystem::path& source_path);
+    void add_subject(source_id id, const std::string& subject_uri);
+
+    std::vector<std::filesystem::path> m_source_paths;
+    /** The source identifiers of each resource (ascending, as the sources are added in order) */
+    std::map<std::string, std::vector<source_id>, std::less<>> m_resource_sources;
+};
+
+/** @brief Build the source index of the model snapshot (the snapshot preserves the provenance)
+ *
+ *  The triples are decoded from the snapshot, no source file is parsed.
+ *
+ *  @throws common_exception (data_format_error) on an invalid term reference */
+source_index build_source_index(const model_snapshot& snapshot);
+
+} // namespace common
+
+#endif // !defined COMMON_SOURCE_INDEX_HPP
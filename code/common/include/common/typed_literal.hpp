@@ -0,0 +1,88 @@
+#if !defined COMMON_TYPED_LITERAL_HPP
+#define COMMON_TYPED_LITERAL_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "common/date.hpp"
+#include "common/redland_utils.hpp"
+
+namespace common
+{
+
+inline constexpr std::string_view k_xsd_boolean = "http://www.w3.org/2001/XMLSchema#boolean";
+inline constexpr std::string_view k_xsd_date = "http://www.w3.org/2001/XMLSchema#date";
+inline constexpr std::string_view k_xsd_integer = "http://www.w3.org/2001/XMLSchema#integer";
+inline constexpr std::string_view k_xsd_int = "http://www.w3.org/2001/XMLSchema#int";
+inline constexpr std::string_view k_xsd_long = "http://www.w3.org/2001/XMLSchema#long";
+
+/** @brief Value of a query result cell converted according to its literal datatype
+ *
+ *  The string_view alternative holds the lexical form of the values with no registered converter
+ *   (the resources, the blank nodes, the plain literals and the other typed literals). The view
+ *   borrows the cell value, so it's valid as long as the value it was converted from. */
+using typed_cell = std::variant<std::string_view, bool, std::int64_t, partial_date>;
+
+/** @brief Conversion of the lexical form of a literal into the typed cell
+ *
+ *  @throws common_exception (data_format_error) when the lexical form is invalid */
+using literal_converter = typed_cell (*)(std::string_view lexical);
+
+/** @brief The literal converters keyed by the datatype uris
+ *
+ *  The lookup table is the datatype keyed counterpart of the binding name keyed extract_cb_lut. */
+using literal_converter_lut = std::map<std::string, literal_converter, std::less<>>;
+
+/** @brief Get the converters of the xsd:boolean, xsd:date and the xsd integer datatypes
+ *
+ *  The xsd:date literals are parsed by the parse_iso_date function, the same as the dates of the
+ *   data_row results (see convert_date), so both query result forms yield the same dates. */
+const literal_converter_lut& get_default_literal_converters();
+
+/** @brief Convert the literal using the converter registered for its datatype
+ *
+ *  The lexical form is returned unchanged when there's no converter of the datatype.
+ *
+ *  @throws common_exception (data_format_error) when the lexical form is invalid */
+typed_cell convert_literal(
+    std::string_view lexical, std::string_view datatype,
+    const literal_converter_lut& lut = get_default_literal_converters());
+
+/** @brief Find the named binding of the streamed row and convert it to the typed cell
+ *
+ *  @return nullopt if the binding is missing or not bound
+ *
+ *  @throws common_exception (data_format_error) when the lexical form is invalid */
+std::optional<typed_cell> find_typed_value(
+    const query_row_view& row, std::string_view binding_name,
+    const literal_converter_lut& lut = get_default_literal_converters());
+
+/** @throws common_exception (data_format_error) on an invalid xsd:boolean lexical form */
+bool parse_xsd_boolean(std::string_view lexical);
+
+/** @throws common_exception (data_format_error) on an invalid or out of range integer */
+std::int64_t parse_xsd_integer(std::string_view lexical);
+
+/** @brief Interpret the cell as the boolean value
+ *
+ *  The untyped cells are parsed as the xsd:boolean lexical forms and the integers are compared to
+ *   zero.
+ *
+ *  @throws common_exception (data_format_error) when the cell can't be interpreted as boolean */
+bool get_boolean(const typed_cell& cell);
+
+/** @brief Interpret the cell as the (possibly partial) date
+ *
+ *  The untyped cells are parsed the same way as the xsd:date literals (see parse_iso_date).
+ *
+ *  @throws common_exception (data_format_error) when the cell can't be interpreted as date */
+partial_date get_date(const typed_cell& cell);
+
+} // namespace common
+
+#endif // !defined COMMON_TYPED_LITERAL_HPP
@@ -0,0 +1,240 @@
+#include "common/column_table.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+
+namespace common
+{
+
+std::string_view string_arena::store(std::string_view value)
+{
+    if (value.empty())
+    {
+        return {};
+    }
+
+    if (value.size() > m_block_free)
+    {
+        // A value larger than the block size gets a dedicated block
+        const std::size_t block_size = std::max(m_block_size, value.size());
+
+        m_blocks.emplace_back(std::make_unique<char[]>(block_size));
+        m_block_used = 0;
+        m_block_free = block_size;
+        m_capacity += block_size;
+    }
+
+    char* target = m_blocks.back().get() + m_block_used;
+    std::memcpy(target, value.data(), value.size());
+
+    m_block_used += value.size();
+    m_block_free -= value.size();
+
+    return { target, value.size() };
+}
+
+column_table::column_table(head_row head)
+    : m_head(std::move(head)), m_columns(m_head.size()), m_datatype_columns(m_head.size())
+{
+}
+
+std::string_view column_table::intern_datatype(std::string_view datatype)
+{
+    if (datatype.empty())
+    {
+        return {};
+    }
+
+    const auto datatype_it = std::find(m_datatypes.begin(), m_datatypes.end(), datatype);
+
+    if (datatype_it != m_datatypes.end())
+    {
+        return *datatype_it;
+    }
+
+    return m_datatypes.emplace_back(m_arena.store(datatype));
+}
+
+std::optional<typed_cell> column_table::get_typed(
+    std::size_t row, column_index column, const literal_converter_lut& lut) const
+{
+    const std::optional<std::string_view> value = get(row, column);
+
+    if (!value)
+    {
+        return std::nullopt;
+    }
+
+    return convert_literal(*value, get_datatype(row, column), lut); // throws common_exception
+}
+
+std::optional<column_table::column_index> column_table::find_column(
+    std::string_view binding_name) const
+{
+    const auto head_it = std::find(m_head.begin(), m_head.end(), binding_name);
+
+    if (head_it == m_head.end())
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<column_index>(head_it - m_head.begin());
+}
+
+column_table::column_index column_table::get_column_req(std::string_view binding_name) const
+{
+    const std::optional<column_index> column = find_column(binding_name);
+
+    if (!column)
+    {
+        throw common_exception(
+            common_exception::error_code::binding_not_found,
+            fmt::format("The '{}' binding not found in the result table head", binding_name));
+    }
+
+    return *column;
+}
+
+std::string_view column_table::get_req(std::size_t row, column_index column) const
+{
+    const std::optional<std::string_view> value = get(row, column);
+
+    if (!value)
+    {
+        throw common_exception(
+            common_exception::error_code::binding_not_found,
+            fmt::format(
+                "The '{}' binding not found in the result table row {}", m_head[column], row));
+    }
+
+    return *value;
+}
+
+void column_table::append_row(
+    std::span<const std::optional<std::string_view>> values,
+    std::span<const std::string_view> datatypes)
+{
+    if ((values.size() != m_head.size()) ||
+        (!datatypes.empty() && (datatypes.size() != m_head.size())))
+    {
+        throw common_exception(
+            common_exception::error_code::input_contract_error,
+            fmt::format(
+                "The appended row has {} values while the table has {} columns", values.size(),
+                m_head.size()));
+    }
+
+    for (column_index column = 0; column < values.size(); ++column)
+    {
+        const std::optional<std::string_view>& value = values[column];
+
+        m_columns[column].emplace_back(
+            value ? std::optional<std::string_view>(m_arena.store(*value)) : std::nullopt);
+        m_datatype_columns[column].emplace_back(
+            datatypes.empty() ? std::string_view() : intern_datatype(datatypes[column]));
+    }
+
+    ++m_row_count;
+}
+
+void column_table::append_row(const query_row_view& row)
+{
+    if (row.size() != m_head.size())
+    {
+        throw common_exception(
+            common_exception::error_code::input_contract_error,
+            fmt::format(
+                "The appended row has {} values while the table has {} columns", row.size(),
+                m_head.size()));
+    }
+
+    for (column_index column = 0; column < row.size(); ++column)
+    {
+        const std::optional<std::string_view> value = row.get_value(column);
+
+        m_columns[column].emplace_back(
+            value ? std::optional<std::string_view>(m_arena.store(*value)) : std::nullopt);
+        m_datatype_columns[column].emplace_back(intern_datatype(row.get_datatype(column)));
+    }
+
+    ++m_row_count;
+}
+
+data_table column_table::to_data_table() const
+{
+    data_table result;
+    result.reserve(m_row_count);
+
+    for (std::size_t row = 0; row < m_row_count; ++row)
+    {
+        data_row& data_row = result.emplace_back();
+
+        for (column_index column = 0; column < m_head.size(); ++column)
+        {
+            if (const std::optional<std::string_view> value = get(row, column))
+            {
+                data_row.emplace(m_head[column], *value);
+            }
+        }
+    }
+
+    return result;
+}
+
+column_table extract_column_table(librdf_query_results* results)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    assert(results);
+
+    // The head is read up front, so the table of an empty result still has its columns
+    head_row head;
+    const int binding_count = librdf_query_results_get_bindings_count(results);
+
+    for (int idx = 0; idx < binding_count; ++idx)
+    {
+        head.emplace_back(librdf_query_results_get_binding_name(results, idx));
+    }
+
+    column_table result(std::move(head));
+
+    visit_query_results(
+        results,
+        [&result](const query_row_view& row) {
+            result.append_row(row); // throws common_exception
+        }); // throws common_exception
+
+    return result;
+}
+
+std::vector<std::string> extract_resource_uri_seq(
+    const column_table& table, std::string_view binding_name)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    std::vector<std::string> result_seq;
+
+    if (table.empty())
+    {
+        return result_seq;
+    }
+
+    const column_table::column_index column =
+        table.get_column_req(binding_name); // throws common_exception
+
+    result_seq.reserve(table.get_row_count());
+
+    for (std::size_t row = 0; row < table.get_row_count(); ++row)
+    {
+        result_seq.emplace_back(table.get_req(row, column)); // throws common_exception
+    }
+
+    return result_seq;
+}
+
+} // namespace common
@@ -0,0 +1,159 @@
+#include "common/date.hpp"
+
+#include <cstdlib>
+
+#include <fmt/format.h>
+
+#include "common/common_exception.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+/** @brief Read up to @p max_digits decimal digits starting at the @p pos position
+ *
+ *  @return the number of the consumed characters (0 if there's no digit at the position) */
+std::size_t read_digits(
+    std::string_view text, std::size_t pos, std::size_t max_digits, int& value) noexcept
+{
+    std::size_t count = 0;
+    value = 0;
+
+    while ((count < max_digits) && (pos + count < text.size()))
+    {
+        const unsigned digit = static_cast<unsigned char>(text[pos + count]) - '0';
+
+        if (digit > 9)
+        {
+            break;
+        }
+
+        value = value * 10 + static_cast<int>(digit);
+        ++count;
+    }
+
+    return count;
+}
+
+} // anonymous namespace
+
+std::optional<std::chrono::year_month_day> partial_date::get_complete() const
+{
+    if (!month || !day)
+    {
+        return std::nullopt;
+    }
+
+    return std::chrono::year_month_day(year, *month, *day);
+}
+
+std::string to_string(const partial_date& date)
+{
+    const int year = static_cast<int>(date.year);
+    std::string result = fmt::format("{}{:04}", (year < 0 ? "-" : ""), std::abs(year));
+
+    if (date.month)
+    {
+        result += fmt::format("-{:02}", static_cast<unsigned>(*date.month));
+
+        if (date.day)
+        {
+            result += fmt::format("-{:02}", static_cast<unsigned>(*date.day));
+        }
+    }
+
+    return result;
+}
+
+std::optional<partial_date> parse_iso_date(std::string_view raw) noexcept
+{
+    std::size_t pos = 0;
+    bool negative = false;
+
+    if (!raw.empty() && ((raw.front() == '-') || (raw.front() == '+')))
+    {
+        negative = (raw.front() == '-');
+        ++pos;
+    }
+
+    int year = 0;
+    const std::size_t year_digits = read_digits(raw, pos, 4, year);
+
+    if (year_digits == 0)
+    {
+        return std::nullopt;
+    }
+
+    pos += year_digits;
+
+    const std::chrono::year y(negative ? -year : year);
+
+    if (pos == raw.size())
+    {
+        return partial_date(y);
+    }
+    else if (raw[pos] != '-')
+    {
+        return std::nullopt;
+    }
+
+    int month = 0;
+    const std::size_t month_digits = read_digits(raw, ++pos, 2, month);
+
+    if ((month_digits == 0) || (month < 1) || (month > 12))
+    {
+        return std::nullopt;
+    }
+
+    pos += month_digits;
+
+    const std::chrono::month m(static_cast<unsigned>(month));
+
+    if (pos == raw.size())
+    {
+        return partial_date(y, m);
+    }
+    else if (raw[pos] != '-')
+    {
+        return std::nullopt;
+    }
+
+    int day = 0;
+    const std::size_t day_digits = read_digits(raw, ++pos, 2, day);
+    const std::chrono::year_month_day ymd(y, m, std::chrono::day(static_cast<unsigned>(day)));
+    pos += day_digits;
+
+    // The text following the day is ignored, the same as by the std::chrono::parse function,
+    //  unless it continues the day digits (e.g. the '01-02-2003' day-month-year form)
+    int extra_digit = 0;
+
+    if ((day_digits == 0) || !ymd.ok() || (read_digits(raw, pos, 1, extra_digit) != 0))
+    {
+        return std::nullopt;
+    }
+
+    return partial_date(ymd);
+}
+
+partial_date convert_date(std::string_view raw)
+{
+    const std::optional<partial_date> result = parse_iso_date(raw);
+
+    // The parsing will fail when:
+    //  * the input format is not valid ('01-02-2003' in not valid while '2003-02-01', '2003-02'
+    //    and '2003' are valid);
+    //  * the successfully parsed input value doesn't represent a valid date, e.g. the month number
+    //     is out of range or the day is out of range for given year and month:
+    if (!result)
+    {
+        throw common_exception(
+            common_exception::error_code::data_format_error,
+            fmt::format("The birth date has unexpected format: '{}'", raw));
+    }
+
+    return *result;
+}
+
+} // namespace common
@@ -0,0 +1,221 @@
+#include "common/file_fingerprint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <system_error>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+#include "common/file_system_utils.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::uint64_t k_fnv_offset_basis = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t k_fnv_prime = 0x100000001b3ULL;
+
+std::uint64_t update_hash(std::uint64_t hash, std::string_view data)
+{
+    for (const char c : data)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= k_fnv_prime;
+    }
+
+    return hash;
+}
+
+[[noreturn]] void throw_file_error(
+    const std::filesystem::path& file_path, const char* operation, const std::string& reason)
+{
+    spdlog::error("Failed to {} the '{}' file: {}", operation, file_path, reason);
+
+    throw common_exception(
+        common_exception::error_code::general_runtime_error,
+        fmt::format("Failed to {} the '{}' file: {}", operation, file_path, reason));
+}
+
+/** @brief Check if the file has the very content (its size is expected to match already)
+ *
+ *  The file is compared chunk by chunk, so it is never read as a whole and the reading stops at
+ *   the first difference. */
+bool has_file_content(const std::filesystem::path& file_path, std::string_view content)
+{
+    std::ifstream is(file_path, std::ios::binary);
+
+    if (!is)
+    {
+        throw_file_error(file_path, "open", "the file can't be opened for reading");
+    }
+
+    std::array<char, 64 * 1024> buffer {};
+
+    while (is)
+    {
+        is.read(buffer.data(), buffer.size());
+
+        const auto chunk_size = static_cast<std::size_t>(is.gcount());
+
+        if ((chunk_size > content.size()) ||
+            !std::equal(buffer.data(), buffer.data() + chunk_size, content.data()))
+        {
+            return false;
+        }
+
+        content.remove_prefix(chunk_size);
+    }
+
+    if (is.bad())
+    {
+        throw_file_error(file_path, "read", "an i/o error occurred");
+    }
+
+    return content.empty();
+}
+
+} // anonymous namespace
+
+std::uint64_t hash_bytes(std::string_view data)
+{
+    return update_hash(k_fnv_offset_basis, data);
+}
+
+file_fingerprint stat_file(const std::filesystem::path& file_path)
+{
+    std::error_code ec;
+    file_fingerprint result;
+
+    result.size = std::filesystem::file_size(file_path, ec);
+
+    if (ec)
+    {
+        throw_file_error(file_path, "stat", ec.message());
+    }
+
+    const auto mtime = std::filesystem::last_write_time(file_path, ec);
+
+    if (ec)
+    {
+        throw_file_error(file_path, "stat", ec.message());
+    }
+
+    result.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+
+    return result;
+}
+
+file_fingerprint fingerprint_file(const std::filesystem::path& file_path)
+{
+    file_fingerprint result = stat_file(file_path);
+
+    std::ifstream is(file_path, std::ios::binary);
+
+    if (!is)
+    {
+        throw_file_error(file_path, "open", "the file can't be opened for reading");
+    }
+
+    std::array<char, 64 * 1024> buffer {};
+    std::uint64_t hash = k_fnv_offset_basis;
+
+    while (is)
+    {
+        is.read(buffer.data(), buffer.size());
+        hash = update_hash(
+            hash, std::string_view(buffer.data(), static_cast<std::size_t>(is.gcount())));
+    }
+
+    if (is.bad())
+    {
+        throw_file_error(file_path, "read", "an i/o error occurred");
+    }
+
+    result.content_hash = hash;
+
+    return result;
+}
+
+bool is_file_unchanged(const std::filesystem::path& file_path, file_fingerprint& fingerprint)
+{
+    file_fingerprint current = stat_file(file_path);
+
+    if (current.size != fingerprint.size)
+    {
+        return false;
+    }
+
+    if (current.mtime == fingerprint.mtime)
+    {
+        return true;
+    }
+
+    current = fingerprint_file(file_path);
+
+    if (current.content_hash != fingerprint.content_hash)
+    {
+        return false;
+    }
+
+    spdlog::debug(
+        "{}: The '{}' file was touched, but its content is unchanged", __func__, file_path);
+
+    fingerprint = current;
+
+    return true;
+}
+
+write_outcome write_file_if_changed(
+    const std::filesystem::path& file_path, std::string_view content)
+{
+    std::error_code ec;
+
+    // The size check avoids reading the existing file in the most common case of a changed file
+    if (std::filesystem::is_regular_file(file_path, ec) &&
+        (std::filesystem::file_size(file_path, ec) == content.size()) && !ec &&
+        has_file_content(file_path, content))
+    {
+        spdlog::debug("{}: The '{}' file is up to date", __func__, file_path);
+        return write_outcome::unchanged;
+    }
+
+    if (file_path.has_parent_path())
+    {
+        std::filesystem::create_directories(file_path.parent_path(), ec);
+
+        if (ec)
+        {
+            throw_file_error(file_path.parent_path(), "create", ec.message());
+        }
+    }
+
+    std::filesystem::path tmp_path = file_path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream os(tmp_path, std::ios::binary | std::ios::trunc);
+        os.write(content.data(), static_cast<std::streamsize>(content.size()));
+        os.close();
+
+        if (!os)
+        {
+            throw_file_error(tmp_path, "write", "an i/o error occurred");
+        }
+    }
+
+    std::filesystem::rename(tmp_path, file_path, ec);
+
+    if (ec)
+    {
+        throw_file_error(file_path, "replace", ec.message());
+    }
+
+    return write_outcome::written;
+}
+
+} // namespace common
@@ -0,0 +1,120 @@
+#include "common/graph_traversal.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+librdf_node* new_pattern_node(librdf_world* world, const std::optional<rdf_term>& term)
+{
+    return (term ? new_librdf_node(world, *term) : nullptr);
+}
+
+librdf_statement* new_pattern_statement(librdf_world* world, const rdf_triple_pattern& pattern)
+{
+    librdf_node* subject = new_pattern_node(world, pattern.subject);
+    librdf_node* predicate = nullptr;
+    librdf_node* object = nullptr;
+
+    try
+    {
+        predicate = new_pattern_node(world, pattern.predicate);
+        object = new_pattern_node(world, pattern.object);
+    }
+    catch (const common_exception&)
+    {
+        if (subject)
+        {
+            librdf_free_node(subject);
+        }
+
+        if (predicate)
+        {
+            librdf_free_node(predicate);
+        }
+
+        throw;
+    }
+
+    // The statement takes the ownership of the nodes
+    librdf_statement* statement = librdf_new_statement_from_nodes(
+        world, subject, predicate, object);
+
+    if (!statement)
+    {
+        throw common_exception(
+            common_exception::error_code::redland_unexpected_behavior,
+            "Failed to create a redland pattern statement");
+    }
+
+    return statement;
+}
+
+} // anonymous namespace
+
+rdf_term make_uri_term(std::string_view uri)
+{
+    return rdf_term{ .type=rdf_term::kind::uri, .value=std::string(uri), .datatype={},
+                     .language={} };
+}
+
+void visit_triples(
+    librdf_world* world, librdf_model* model, const rdf_triple_pattern& pattern,
+    const triple_visitor& visitor)
+{
+    librdf_statement* statement = new_pattern_statement(world, pattern);
+    librdf_stream* stream = librdf_model_find_statements(model, statement);
+
+    if (!stream)
+    {
+        librdf_free_statement(statement);
+
+        throw common_exception(
+            common_exception::error_code::redland_unexpected_behavior,
+            "Failed to find the model statements matching the pattern");
+    }
+
+    try
+    {
+        for (; !librdf_stream_end(stream); librdf_stream_next(stream))
+        {
+            // The stream keeps the ownership of the statement
+            librdf_statement* found = librdf_stream_get_object(stream);
+
+            visitor({
+                    .subject=to_rdf_term(librdf_statement_get_subject(found)),
+                    .predicate=to_rdf_term(librdf_statement_get_predicate(found)),
+                    .object=to_rdf_term(librdf_statement_get_object(found))
+                });
+        }
+    }
+    catch (...)
+    {
+        librdf_free_stream(stream);
+        librdf_free_statement(statement);
+
+        throw;
+    }
+
+    librdf_free_stream(stream);
+    librdf_free_statement(statement);
+}
+
+rdf_triple_buffer find_triples(
+    librdf_world* world, librdf_model* model, const rdf_triple_pattern& pattern)
+{
+    rdf_triple_buffer result;
+
+    visit_triples(
+        world, model, pattern,
+        [&result](const rdf_triple& triple) { result.push_back(triple); });
+
+    return result;
+}
+
+} // namespace common
@@ -0,0 +1,198 @@
+#include "common/json_writer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <string>
+
+namespace common
+{
+
+void json_writer::begin_object()
+{
+    begin_container('{');
+}
+
+void json_writer::end_object()
+{
+    end_container('}');
+}
+
+void json_writer::begin_array()
+{
+    begin_container('[');
+}
+
+void json_writer::end_array()
+{
+    end_container(']');
+}
+
+void json_writer::key(std::string_view name)
+{
+    begin_value();
+    write_string(name);
+
+    if (m_indent >= 0)
+    {
+        m_os.write(": ", 2);
+    }
+    else
+    {
+        m_os.put(':');
+    }
+
+    m_after_key = true;
+}
+
+void json_writer::value(std::string_view text)
+{
+    begin_value();
+    write_string(text);
+}
+
+void json_writer::value(bool flag)
+{
+    begin_value();
+    m_os << (flag ? "true" : "false");
+}
+
+void json_writer::value(std::int64_t number)
+{
+    begin_value();
+
+    std::array<char, 24> buffer {};
+    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number);
+    m_os.write(buffer.data(), end - buffer.data());
+}
+
+void json_writer::null_value()
+{
+    begin_value();
+    m_os.write("null", 4);
+}
+
+void json_writer::embed(const nlohmann::json& subtree)
+{
+    begin_value();
+
+    // The dump function indents the subtree as a top level document, so the nested lines have to
+    //  be shifted by the current depth (the strings can't contain raw line breaks)
+    const std::string text = subtree.dump(m_indent);
+    const std::string shift(m_frames.size() * static_cast<std::size_t>(std::max(m_indent, 0)), ' ');
+    std::size_t begin = 0;
+
+    for (std::size_t end = text.find('\n'); end != std::string::npos; end = text.find('\n', begin))
+    {
+        m_os.write(text.data() + begin, static_cast<std::streamsize>(end - begin + 1));
+        m_os.write(shift.data(), static_cast<std::streamsize>(shift.size()));
+        begin = end + 1;
+    }
+
+    m_os.write(text.data() + begin, static_cast<std::streamsize>(text.size() - begin));
+}
+
+void json_writer::begin_value()
+{
+    if (m_after_key)
+    {
+        m_after_key = false;
+        return;
+    }
+
+    if (m_frames.empty())
+    {
+        return;
+    }
+
+    frame& current = m_frames.back();
+
+    if (!current.is_empty)
+    {
+        m_os.put(',');
+    }
+
+    current.is_empty = false;
+    write_line_break(m_frames.size());
+}
+
+void json_writer::begin_container(char opening)
+{
+    begin_value();
+    m_os.put(opening);
+    m_frames.push_back({ .is_empty = true });
+}
+
+void json_writer::end_container(char closing)
+{
+    const bool is_empty = m_frames.back().is_empty;
+    m_frames.pop_back();
+
+    // The empty containers are written as '{}' and '[]', the same as by the dump function
+    if (!is_empty)
+    {
+        write_line_break(m_frames.size());
+    }
+
+    m_os.put(closing);
+}
+
+void json_writer::write_line_break(std::size_t depth)
+{
+    if (m_indent < 0)
+    {
+        return;
+    }
+
+    m_os.put('\n');
+
+    for (std::size_t idx = 0; idx < depth * static_cast<std::size_t>(m_indent); ++idx)
+    {
+        m_os.put(' ');
+    }
+}
+
+void json_writer::write_string(std::string_view text)
+{
+    static constexpr char k_hex_digits[] = "0123456789abcdef";
+
+    m_os.put('"');
+
+    std::size_t run_begin = 0;
+
+    for (std::size_t idx = 0; idx < text.size(); ++idx)
+    {
+        const auto c = static_cast<unsigned char>(text[idx]);
+
+        if ((c >= 0x20) && (c != '"') && (c != '\\'))
+        {
+            continue;
+        }
+
+        // Flush the run of the characters that need no escaping
+        m_os.write(text.data() + run_begin, static_cast<std::streamsize>(idx - run_begin));
+        run_begin = idx + 1;
+
+        switch (c)
+        {
+        case '"': m_os.write("\\\"", 2); break;
+        case '\\': m_os.write("\\\\", 2); break;
+        case '\b': m_os.write("\\b", 2); break;
+        case '\f': m_os.write("\\f", 2); break;
+        case '\n': m_os.write("\\n", 2); break;
+        case '\r': m_os.write("\\r", 2); break;
+        case '\t': m_os.write("\\t", 2); break;
+        default:
+        {
+            const std::array<char, 6> escape {
+                '\\', 'u', '0', '0', k_hex_digits[c >> 4], k_hex_digits[c & 0x0f] };
+            m_os.write(escape.data(), escape.size());
+        }
+        }
+    }
+
+    m_os.write(text.data() + run_begin, static_cast<std::streamsize>(text.size() - run_begin));
+    m_os.put('"');
+}
+
+} // namespace common
@@ -0,0 +1,278 @@
+#include "common/model_cache.hpp"
+
+#include <fstream>
+#include <system_error>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+#include "common/model_snapshot.hpp"
+#include "common/rdf_term.hpp"
+#include "common/redland_utils.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+constexpr int k_manifest_version = 1;
+
+using snapshot_source_lut = std::map<std::filesystem::path, std::size_t>;
+
+scoped_model_snapshot open_cached_snapshot(const std::filesystem::path& cache_path)
+{
+    if (!std::filesystem::exists(cache_path))
+    {
+        spdlog::debug("{}: The '{}' model cache doesn't exist", __func__, cache_path);
+
+        return { nullptr, release_model_snapshot };
+    }
+
+    try
+    {
+        return open_model_snapshot(cache_path);
+    }
+    catch (const common_exception& e)
+    {
+        // The cache will be rebuilt from scratch
+        spdlog::warn("{}: Ignoring the '{}' model cache: {}", __func__, cache_path, e.what());
+
+        return { nullptr, release_model_snapshot };
+    }
+}
+
+snapshot_source_lut index_snapshot_sources(const model_snapshot* snapshot)
+{
+    snapshot_source_lut result;
+
+    if (snapshot)
+    {
+        for (std::size_t idx = 0; idx < get_snapshot_source_count(*snapshot); ++idx)
+        {
+            result.emplace(get_snapshot_source_path(*snapshot, idx), idx);
+        }
+    }
+
+    return result;
+}
+
+} // anonymous namespace
+
+std::filesystem::path get_input_manifest_path(const std::filesystem::path& cache_path)
+{
+    std::filesystem::path result = cache_path;
+    result += ".manifest.json";
+    return result;
+}
+
+input_manifest read_input_manifest(const std::filesystem::path& manifest_path)
+{
+    std::ifstream is(manifest_path);
+
+    if (!is)
+    {
+        spdlog::debug("{}: The '{}' manifest doesn't exist", __func__, manifest_path);
+
+        return {};
+    }
+
+    input_manifest result;
+
+    try
+    {
+        const nlohmann::json doc = nlohmann::json::parse(is);
+
+        if (doc.at("version").get<int>() != k_manifest_version)
+        {
+            spdlog::warn(
+                "{}: Ignoring the '{}' manifest of unsupported version", __func__, manifest_path);
+
+            return {};
+        }
+
+        for (const auto& file : doc.at("files"))
+        {
+            input_manifest_entry entry;
+            entry.fingerprint.size = file.at("size").get<std::uint64_t>();
+            entry.fingerprint.mtime = file.at("mtime").get<std::int64_t>();
+            entry.fingerprint.content_hash = file.at("hash").get<std::uint64_t>();
+            entry.triple_count = file.at("triples").get<std::uint64_t>();
+
+            result.emplace(file.at("path").get<std::string>(), entry);
+        }
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        spdlog::warn(
+            "{}: Ignoring the malformed '{}' manifest: {}", __func__, manifest_path, e.what());
+
+        return {};
+    }
+
+    return result;
+}
+
+void write_input_manifest(
+    const std::filesystem::path& manifest_path, const input_manifest& manifest)
+{
+    nlohmann::json doc;
+    doc["version"] = k_manifest_version;
+    doc["files"] = nlohmann::json::array();
+
+    for (const auto& [path, entry] : manifest)
+    {
+        doc["files"].push_back({
+                { "path", path.string() },
+                { "size", entry.fingerprint.size },
+                { "mtime", entry.fingerprint.mtime },
+                { "hash", entry.fingerprint.content_hash },
+                { "triples", entry.triple_count }
+            });
+    }
+
+    std::filesystem::path tmp_path = manifest_path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream os(tmp_path, std::ios::trunc);
+        os << doc.dump(4) << '\n';
+        os.close();
+
+        if (!os)
+        {
+            throw common_exception(
+                common_exception::error_code::general_runtime_error,
+                fmt::format("Failed to write the '{}' manifest file", tmp_path));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, manifest_path, ec);
+
+    if (ec)
+    {
+        throw common_exception(
+            common_exception::error_code::general_runtime_error,
+            fmt::format("Failed to replace the '{}' manifest file", manifest_path));
+    }
+}
+
+void load_rdf_set_cached(
+    librdf_world* world, librdf_model* model, const input_files& input_file_paths,
+    unsigned int thread_count, const std::filesystem::path& cache_path)
+{
+    spdlog::trace("{}: Entry checkpoint ({})", __func__, cache_path);
+
+    const std::filesystem::path manifest_path = get_input_manifest_path(cache_path);
+    const input_manifest old_manifest = read_input_manifest(manifest_path);
+
+    scoped_model_snapshot cache = open_cached_snapshot(cache_path);
+    const snapshot_source_lut cached_sources = index_snapshot_sources(cache.get());
+
+    input_manifest new_manifest;
+    snapshot_source_lut reused_sources;
+    input_files changed_files;
+    bool manifest_refreshed = false;
+
+    for (const auto& path : input_file_paths)
+    {
+        const auto manifest_it = old_manifest.find(path);
+        const auto source_it = cached_sources.find(path);
+
+        if ((manifest_it != old_manifest.end()) && (source_it != cached_sources.end()))
+        {
+            input_manifest_entry entry = manifest_it->second;
+
+            if (is_file_unchanged(path, entry.fingerprint))
+            {
+                manifest_refreshed |= !(entry.fingerprint == manifest_it->second.fingerprint);
+                new_manifest.emplace(path, entry);
+                reused_sources.emplace(path, source_it->second);
+                continue;
+            }
+        }
+
+        changed_files.insert(path);
+    }
+
+    const std::size_t dropped_count = cached_sources.size() - reused_sources.size();
+
+    spdlog::info(
+        "{}: {} unchanged, {} new or changed and {} removed or changed input files",
+        __func__, reused_sources.size(), changed_files.size(), dropped_count);
+
+    if (cache && changed_files.empty() && (dropped_count == 0))
+    {
+        load_model_snapshot(world, model, *cache);
+
+        if (manifest_refreshed)
+        {
+            write_input_manifest(manifest_path, new_manifest);
+        }
+
+        return;
+    }
+
+    // The fingerprints are taken before parsing, so a file modified in the meantime is re-parsed
+    //  on the next run rather than cached with the outdated content
+    for (const auto& path : changed_files)
+    {
+        new_manifest[path].fingerprint = fingerprint_file(path);
+    }
+
+    std::map<std::filesystem::path, rdf_triple_buffer> parsed_files;
+    input_files failed_files;
+
+    parse_rdf_set(
+        changed_files, thread_count,
+        [&parsed_files, &failed_files](
+            std::size_t, const std::filesystem::path& file_path, rdf_triple_buffer&& triples,
+            bool complete) {
+            if (!complete)
+            {
+                failed_files.insert(file_path);
+            }
+
+            parsed_files.emplace(file_path, std::move(triples));
+        });
+
+    model_snapshot_builder builder;
+
+    for (const auto& path : input_file_paths)
+    {
+        if (const auto reused_it = reused_sources.find(path); reused_it != reused_sources.end())
+        {
+            load_model_snapshot_source(world, model, *cache, reused_it->second);
+            builder.add_source(path, read_model_snapshot_source(*cache, reused_it->second));
+        }
+        else if (failed_files.contains(path))
+        {
+            // The statements parsed before the error are loaded (the same as by load_rdf), but
+            //  the file is left out of the cache, so it's parsed again on the next run
+            add_rdf_triples(world, model, parsed_files.at(path));
+            new_manifest.erase(path);
+        }
+        else
+        {
+            const rdf_triple_buffer& triples = parsed_files.at(path);
+
+            add_rdf_triples(world, model, triples);
+            builder.add_source(path, triples);
+            new_manifest[path].triple_count = triples.size();
+        }
+    }
+
+    // The snapshot is replaced by renaming, so the old mapping would stay valid anyway; it is
+    //  released early only to free the memory
+    cache.reset();
+
+    // The snapshot is written first. Should the manifest update fail, the stale manifest entries
+    //  of the changed files won't match the files and the files will be re-parsed on the next run.
+    builder.write(cache_path);
+    write_input_manifest(manifest_path, new_manifest);
+}
+
+} // namespace common
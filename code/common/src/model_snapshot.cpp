@@ -0,0 +1,724 @@
+#include "common/model_snapshot.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+#include "common/file_system_utils.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::array<char, 8> k_magic = { 'G', 'E', 'N', 'S', 'N', 'A', 'P', '\0' };
+constexpr std::uint32_t k_format_version = 1;
+constexpr std::uint32_t k_byte_order_mark = 0x01020304;
+constexpr snapshot_term_id k_no_term = std::numeric_limits<snapshot_term_id>::max();
+
+struct header_record
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint32_t term_count;
+    std::uint32_t source_count;
+    std::uint64_t triple_count;
+    std::uint64_t string_pool_size;
+};
+
+struct term_record
+{
+    std::uint64_t value_offset;
+    std::uint64_t language_offset;
+    std::uint32_t value_size;
+    std::uint32_t language_size;
+    snapshot_term_id datatype_id;
+    std::uint8_t kind;
+    std::array<std::uint8_t, 3> reserved;
+};
+
+struct source_record
+{
+    std::uint64_t path_offset;
+    std::uint64_t first_triple;
+    std::uint64_t triple_count;
+    std::uint32_t path_size;
+    std::uint32_t reserved;
+};
+
+struct triple_record
+{
+    snapshot_term_id subject;
+    snapshot_term_id predicate;
+    snapshot_term_id object;
+};
+
+static_assert(sizeof(header_record) == 40 && std::is_trivially_copyable_v<header_record>);
+static_assert(sizeof(term_record) == 32 && std::is_trivially_copyable_v<term_record>);
+static_assert(sizeof(source_record) == 32 && std::is_trivially_copyable_v<source_record>);
+static_assert(sizeof(triple_record) == 12 && std::is_trivially_copyable_v<triple_record>);
+
+/** Offsets of the snapshot sections calculated from (and validated against) the header */
+struct snapshot_layout
+{
+    header_record header;
+    std::size_t terms_offset;
+    std::size_t sources_offset;
+    std::size_t triples_offset;
+    std::size_t pool_offset;
+};
+
+template<class Record>
+Record read_record(const model_snapshot& snapshot, std::size_t offset)
+{
+    Record record;
+    std::memcpy(&record, snapshot.data + offset, sizeof(Record));
+    return record;
+}
+
+[[noreturn]] void throw_format_error(const std::string& msg)
+{
+    spdlog::error("Invalid model snapshot: {}", msg);
+
+    throw common_exception(
+        common_exception::error_code::data_format_error,
+        fmt::format("Invalid model snapshot: {}", msg));
+}
+
+snapshot_layout read_layout(const model_snapshot& snapshot)
+{
+    if (snapshot.size < sizeof(header_record))
+    {
+        throw_format_error(fmt::format("the file is too small ({} bytes)", snapshot.size));
+    }
+
+    snapshot_layout layout {};
+    layout.header = read_record<header_record>(snapshot, 0);
+
+    if (layout.header.magic != k_magic)
+    {
+        throw_format_error("unrecognized file signature");
+    }
+
+    if (layout.header.version != k_format_version)
+    {
+        throw_format_error(
+            fmt::format(
+                "unsupported format version (expected {}; observed {})",
+                k_format_version, layout.header.version));
+    }
+
+    if (layout.header.byte_order_mark != k_byte_order_mark)
+    {
+        throw_format_error("the snapshot was created on a platform of different byte order");
+    }
+
+    layout.terms_offset = sizeof(header_record);
+    layout.sources_offset =
+        layout.terms_offset + std::size_t{layout.header.term_count} * sizeof(term_record);
+    layout.triples_offset =
+        layout.sources_offset + std::size_t{layout.header.source_count} * sizeof(source_record);
+
+    // Each of the triple records takes 12 bytes, so the multiplication overflows only for a
+    //  triple count that couldn't have been produced by the model_snapshot_builder anyway:
+    if (layout.header.triple_count > snapshot.size / sizeof(triple_record))
+    {
+        throw_format_error(
+            fmt::format("the triple count is too large ({})", layout.header.triple_count));
+    }
+
+    layout.pool_offset =
+        layout.triples_offset + layout.header.triple_count * sizeof(triple_record);
+
+    if ((layout.pool_offset > snapshot.size) ||
+        (layout.header.string_pool_size != snapshot.size - layout.pool_offset))
+    {
+        throw_format_error(
+            fmt::format(
+                "the section sizes don't match the file size (expected {} bytes; observed {})",
+                layout.pool_offset + layout.header.string_pool_size, snapshot.size));
+    }
+
+    return layout;
+}
+
+/** Get a null terminated string stored in the snapshot string pool */
+const char* get_pool_string(
+    const model_snapshot& snapshot, const snapshot_layout& layout,
+    std::uint64_t offset, std::uint32_t size)
+{
+    if ((offset >= layout.header.string_pool_size) ||
+        (size >= layout.header.string_pool_size - offset) ||
+        (snapshot.data[layout.pool_offset + offset + size] != std::byte{0}))
+    {
+        throw_format_error(
+            fmt::format("invalid string reference (offset: {}, size: {})", offset, size));
+    }
+
+    return reinterpret_cast<const char*>(snapshot.data + layout.pool_offset + offset);
+}
+
+term_record get_term_record(
+    const model_snapshot& snapshot, const snapshot_layout& layout, snapshot_term_id term_id)
+{
+    if (term_id >= layout.header.term_count)
+    {
+        throw_format_error(
+            fmt::format(
+                "invalid term reference (term id: {}; term count: {})",
+                term_id, layout.header.term_count));
+    }
+
+    return read_record<term_record>(
+        snapshot, layout.terms_offset + std::size_t{term_id} * sizeof(term_record));
+}
+
+source_record get_source_record(
+    const model_snapshot& snapshot, const snapshot_layout& layout, std::size_t source_idx)
+{
+    if (source_idx >= layout.header.source_count)
+    {
+        throw common_exception(
+            common_exception::error_code::input_contract_error,
+            fmt::format(
+                "Precondition failure: source_idx={} must satisfy < {}",
+                source_idx, layout.header.source_count));
+    }
+
+    const auto record = read_record<source_record>(
+        snapshot, layout.sources_offset + source_idx * sizeof(source_record));
+
+    if ((record.first_triple > layout.header.triple_count) ||
+        (record.triple_count > layout.header.triple_count - record.first_triple))
+    {
+        throw_format_error(
+            fmt::format("invalid triple range of the source #{}", source_idx));
+    }
+
+    return record;
+}
+
+rdf_term make_datatype_term(const std::string& datatype_uri)
+{
+    rdf_term term;
+    term.type = rdf_term::kind::uri;
+    term.value = datatype_uri;
+    return term;
+}
+
+const unsigned char* as_uchar_str(const char* str)
+{
+    return reinterpret_cast<const unsigned char*>(str);
+}
+
+/** Lazily constructed Redland nodes of the snapshot terms
+ *
+ * Every term node is created at most once per load and copied for every statement using it. */
+class snapshot_node_cache
+{
+public:
+    snapshot_node_cache(
+        librdf_world* world, const model_snapshot& snapshot, const snapshot_layout& layout)
+        : m_world(world), m_snapshot(snapshot), m_layout(layout),
+          m_nodes(layout.header.term_count, nullptr) {}
+
+    snapshot_node_cache(const snapshot_node_cache&) = delete;
+    snapshot_node_cache& operator=(const snapshot_node_cache&) = delete;
+
+    ~snapshot_node_cache()
+    {
+        for (librdf_node* node : m_nodes)
+        {
+            if (node)
+            {
+                librdf_free_node(node);
+            }
+        }
+    }
+
+    /** Get a new copy of the term node (the caller takes the ownership) */
+    librdf_node* copy_node(snapshot_term_id term_id)
+    {
+        return librdf_new_node_from_node(get_node(term_id));
+    }
+
+private:
+    librdf_node* get_node(snapshot_term_id term_id)
+    {
+        const term_record record = get_term_record(m_snapshot, m_layout, term_id);
+
+        if (!m_nodes[term_id])
+        {
+            m_nodes[term_id] = create_node(record);
+        }
+
+        return m_nodes[term_id];
+    }
+
+    librdf_node* create_node(const term_record& record)
+    {
+        const char* value = get_pool_string(
+            m_snapshot, m_layout, record.value_offset, record.value_size);
+
+        librdf_node* node = nullptr;
+
+        switch (static_cast<rdf_term::kind>(record.kind))
+        {
+        case rdf_term::kind::uri:
+            node = librdf_new_node_from_uri_string(m_world, as_uchar_str(value));
+            break;
+        case rdf_term::kind::blank:
+            node = librdf_new_node_from_blank_identifier(m_world, as_uchar_str(value));
+            break;
+        case rdf_term::kind::literal:
+            node = create_literal_node(record, value);
+            break;
+        default:
+            throw_format_error(fmt::format("invalid term kind ({})", record.kind));
+        }
+
+        if (!node)
+        {
+            throw common_exception(
+                common_exception::error_code::redland_unexpected_behavior,
+                fmt::format("Failed to create a redland node: '{}'", value));
+        }
+
+        return node;
+    }
+
+    librdf_node* create_literal_node(const term_record& record, const char* value)
+    {
+        if (record.datatype_id == k_no_term)
+        {
+            const char* language = (
+                record.language_size == 0 ? nullptr :
+                get_pool_string(
+                    m_snapshot, m_layout, record.language_offset, record.language_size));
+
+            return librdf_new_node_from_typed_literal(
+                m_world, as_uchar_str(value), language, nullptr);
+        }
+
+        const term_record datatype_record =
+            get_term_record(m_snapshot, m_layout, record.datatype_id);
+        librdf_uri* datatype_uri = librdf_new_uri(
+            m_world,
+            as_uchar_str(
+                get_pool_string(
+                    m_snapshot, m_layout,
+                    datatype_record.value_offset, datatype_record.value_size)));
+
+        if (!datatype_uri)
+        {
+            return nullptr;
+        }
+
+        librdf_node* node = librdf_new_node_from_typed_literal(
+            m_world, as_uchar_str(value), nullptr, datatype_uri);
+
+        // The node holds its own reference to the datatype uri
+        librdf_free_uri(datatype_uri);
+
+        return node;
+    }
+
+    librdf_world* m_world;
+    const model_snapshot& m_snapshot;
+    const snapshot_layout& m_layout;
+    std::vector<librdf_node*> m_nodes;
+};
+
+rdf_term read_term(
+    const model_snapshot& snapshot, const snapshot_layout& layout, snapshot_term_id term_id)
+{
+    const term_record record = get_term_record(snapshot, layout, term_id);
+
+    if (record.kind > static_cast<std::uint8_t>(rdf_term::kind::blank))
+    {
+        throw_format_error(fmt::format("invalid term kind ({})", record.kind));
+    }
+
+    rdf_term term;
+    term.type = static_cast<rdf_term::kind>(record.kind);
+    term.value = get_pool_string(snapshot, layout, record.value_offset, record.value_size);
+
+    if (record.datatype_id != k_no_term)
+    {
+        const term_record datatype_record = get_term_record(snapshot, layout, record.datatype_id);
+        term.datatype = get_pool_string(
+            snapshot, layout, datatype_record.value_offset, datatype_record.value_size);
+    }
+
+    if (record.language_size != 0)
+    {
+        term.language = get_pool_string(
+            snapshot, layout, record.language_offset, record.language_size);
+    }
+
+    return term;
+}
+
+void load_triple_range(
+    librdf_world* world, librdf_model* model, const model_snapshot& snapshot,
+    const snapshot_layout& layout, std::uint64_t first_triple, std::uint64_t triple_count)
+{
+    snapshot_node_cache node_cache(world, snapshot, layout);
+
+    for (std::uint64_t idx = first_triple; idx < first_triple + triple_count; ++idx)
+    {
+        const auto triple = read_record<triple_record>(
+            snapshot, layout.triples_offset + idx * sizeof(triple_record));
+
+        // The statement takes the ownership of the node copies
+        librdf_statement* statement = librdf_new_statement_from_nodes(
+            world,
+            node_cache.copy_node(triple.subject),
+            node_cache.copy_node(triple.predicate),
+            node_cache.copy_node(triple.object));
+
+        if (!statement)
+        {
+            throw common_exception(
+                common_exception::error_code::redland_unexpected_behavior,
+                "Failed to create a redland statement");
+        }
+
+        const int add_error = librdf_model_add_statement(model, statement);
+        librdf_free_statement(statement);
+
+        if (add_error)
+        {
+            throw common_exception(
+                common_exception::error_code::redland_unexpected_behavior,
+                "Failed to add a snapshot statement to the redland model");
+        }
+    }
+}
+
+[[noreturn]] void throw_output_error(const std::filesystem::path& path, const char* operation)
+{
+    spdlog::error("Failed to {} the '{}' snapshot file", operation, path);
+
+    throw common_exception(
+        common_exception::error_code::general_runtime_error,
+        fmt::format("Failed to {} the '{}' snapshot file", operation, path));
+}
+
+template<class Record>
+void write_record(std::ofstream& os, const Record& record)
+{
+    os.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+}
+
+} // anonymous namespace
+
+// ---[ Snapshot Builder ]---------------------------------------------------------------------- //
+
+snapshot_term_id model_snapshot_builder::intern(const rdf_term& term)
+{
+    if (auto term_it = m_term_ids.find(term); term_it != m_term_ids.end())
+    {
+        return term_it->second;
+    }
+
+    if ((term.type == rdf_term::kind::literal) && !term.datatype.empty())
+    {
+        // The datatype uri is referenced by the literal term record, so it has to be interned too
+        intern(make_datatype_term(term.datatype));
+    }
+
+    if (m_terms.size() >= k_no_term)
+    {
+        throw common_exception(
+            common_exception::error_code::data_size_error,
+            fmt::format("Too many distinct terms for a model snapshot ({})", m_terms.size()));
+    }
+
+    const auto term_id = static_cast<snapshot_term_id>(m_terms.size());
+    // The unordered_map element addresses are stable, so they can be referenced by m_terms
+    const auto [term_it, inserted] = m_term_ids.emplace(term, term_id);
+    m_terms.push_back(&term_it->first);
+
+    return term_id;
+}
+
+void model_snapshot_builder::add_source(
+    const std::filesystem::path& source_path, const rdf_triple_buffer& triples)
+{
+    m_sources.push_back({ source_path.string(), m_triples.size(), triples.size() });
+    m_triples.reserve(m_triples.size() + triples.size());
+
+    for (const rdf_triple& triple : triples)
+    {
+        m_triples.push_back({
+            intern(triple.subject), intern(triple.predicate), intern(triple.object) });
+    }
+
+    spdlog::debug(
+        "{}: Added {} triples of the '{}' source (total terms: {})",
+        __func__, triples.size(), source_path, m_terms.size());
+}
+
+void model_snapshot_builder::write(const std::filesystem::path& snapshot_path) const
+{
+    spdlog::trace("{}: Entry checkpoint ({})", __func__, snapshot_path);
+
+    std::string pool;
+    std::vector<term_record> term_records;
+    std::vector<source_record> source_records;
+
+    auto append_to_pool = [&pool](const std::string& str) -> std::uint64_t {
+        const std::uint64_t offset = pool.size();
+        pool.append(str);
+        pool.push_back('\0');
+        return offset;
+    };
+
+    term_records.reserve(m_terms.size());
+
+    for (const rdf_term* term : m_terms)
+    {
+        term_record record {};
+        record.kind = static_cast<std::uint8_t>(term->type);
+        record.value_size = static_cast<std::uint32_t>(term->value.size());
+        record.value_offset = append_to_pool(term->value);
+        record.datatype_id = (
+            term->datatype.empty() ? k_no_term :
+            m_term_ids.at(make_datatype_term(term->datatype)));
+
+        if (!term->language.empty())
+        {
+            record.language_size = static_cast<std::uint32_t>(term->language.size());
+            record.language_offset = append_to_pool(term->language);
+        }
+
+        term_records.push_back(record);
+    }
+
+    source_records.reserve(m_sources.size());
+
+    for (const source& src : m_sources)
+    {
+        source_record record {};
+        record.path_size = static_cast<std::uint32_t>(src.path.size());
+        record.path_offset = append_to_pool(src.path);
+        record.first_triple = src.first_triple;
+        record.triple_count = src.triple_count;
+        source_records.push_back(record);
+    }
+
+    header_record header {};
+    header.magic = k_magic;
+    header.version = k_format_version;
+    header.byte_order_mark = k_byte_order_mark;
+    header.term_count = static_cast<std::uint32_t>(term_records.size());
+    header.source_count = static_cast<std::uint32_t>(source_records.size());
+    header.triple_count = m_triples.size();
+    header.string_pool_size = pool.size();
+
+    std::filesystem::path tmp_path = snapshot_path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream os(tmp_path, std::ios::binary | std::ios::trunc);
+
+        if (!os)
+        {
+            throw_output_error(tmp_path, "create");
+        }
+
+        write_record(os, header);
+
+        for (const auto& record : term_records)
+        {
+            write_record(os, record);
+        }
+
+        for (const auto& record : source_records)
+        {
+            write_record(os, record);
+        }
+
+        for (const auto& triple : m_triples)
+        {
+            write_record(os, triple_record{ triple.subject, triple.predicate, triple.object });
+        }
+
+        os.write(pool.data(), static_cast<std::streamsize>(pool.size()));
+        os.close();
+
+        if (!os)
+        {
+            throw_output_error(tmp_path, "write");
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, snapshot_path, ec);
+
+    if (ec)
+    {
+        throw_output_error(snapshot_path, "replace");
+    }
+
+    spdlog::info(
+        "{}: Written the '{}' snapshot ({} sources, {} terms, {} triples)",
+        __func__, snapshot_path, m_sources.size(), m_terms.size(), m_triples.size());
+}
+
+// ---[ Snapshot Reader ]----------------------------------------------------------------------- //
+
+void release_model_snapshot(model_snapshot* snapshot)
+{
+    if (snapshot->data)
+    {
+        munmap(const_cast<std::byte*>(snapshot->data), snapshot->size);
+    }
+
+    if (snapshot->fd >= 0)
+    {
+        close(snapshot->fd);
+    }
+
+    spdlog::debug("{}: Released the model snapshot", __func__);
+
+    delete snapshot;
+}
+
+scoped_model_snapshot open_model_snapshot(const std::filesystem::path& snapshot_path)
+{
+    spdlog::trace("{}: Entry checkpoint ({})", __func__, snapshot_path);
+
+    scoped_model_snapshot snapshot = { new model_snapshot(), release_model_snapshot };
+
+    snapshot->fd = open(snapshot_path.c_str(), O_RDONLY);
+
+    if (snapshot->fd < 0)
+    {
+        throw common_exception(
+            common_exception::error_code::general_runtime_error,
+            fmt::format(
+                "Failed to open the '{}' snapshot file: {}", snapshot_path, std::strerror(errno)));
+    }
+
+    struct stat file_stat {};
+
+    if (fstat(snapshot->fd, &file_stat) != 0)
+    {
+        throw common_exception(
+            common_exception::error_code::general_runtime_error,
+            fmt::format(
+                "Failed to stat the '{}' snapshot file: {}", snapshot_path, std::strerror(errno)));
+    }
+
+    if (file_stat.st_size == 0)
+    {
+        throw_format_error(fmt::format("the '{}' file is empty", snapshot_path));
+    }
+
+    snapshot->size = static_cast<std::size_t>(file_stat.st_size);
+
+    void* data = mmap(nullptr, snapshot->size, PROT_READ, MAP_PRIVATE, snapshot->fd, 0);
+
+    if (data == MAP_FAILED)
+    {
+        throw common_exception(
+            common_exception::error_code::general_runtime_error,
+            fmt::format(
+                "Failed to map the '{}' snapshot file: {}", snapshot_path, std::strerror(errno)));
+    }
+
+    snapshot->data = static_cast<const std::byte*>(data);
+
+    const snapshot_layout layout = read_layout(*snapshot); // throws on an invalid layout
+
+    spdlog::info(
+        "{}: Opened the '{}' snapshot ({} sources, {} terms, {} triples)",
+        __func__, snapshot_path, layout.header.source_count, layout.header.term_count,
+        layout.header.triple_count);
+
+    return snapshot;
+}
+
+std::size_t get_snapshot_source_count(const model_snapshot& snapshot)
+{
+    return read_layout(snapshot).header.source_count;
+}
+
+std::size_t get_snapshot_triple_count(const model_snapshot& snapshot)
+{
+    return read_layout(snapshot).header.triple_count;
+}
+
+std::filesystem::path get_snapshot_source_path(
+    const model_snapshot& snapshot, std::size_t source_idx)
+{
+    const snapshot_layout layout = read_layout(snapshot);
+    const source_record record = get_source_record(snapshot, layout, source_idx);
+
+    return get_pool_string(snapshot, layout, record.path_offset, record.path_size);
+}
+
+void load_model_snapshot(librdf_world* world, librdf_model* model, const model_snapshot& snapshot)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    const snapshot_layout layout = read_layout(snapshot);
+
+    load_triple_range(world, model, snapshot, layout, 0, layout.header.triple_count);
+
+    spdlog::info(
+        "{}: Loaded {} snapshot triples into the model", __func__, layout.header.triple_count);
+}
+
+void load_model_snapshot_source(
+    librdf_world* world, librdf_model* model, const model_snapshot& snapshot,
+    std::size_t source_idx)
+{
+    spdlog::trace("{}: Entry checkpoint (source #{})", __func__, source_idx);
+
+    const snapshot_layout layout = read_layout(snapshot);
+    const source_record record = get_source_record(snapshot, layout, source_idx);
+
+    load_triple_range(world, model, snapshot, layout, record.first_triple, record.triple_count);
+}
+
+rdf_triple_buffer read_model_snapshot_source(
+    const model_snapshot& snapshot, std::size_t source_idx)
+{
+    const snapshot_layout layout = read_layout(snapshot);
+    const source_record record = get_source_record(snapshot, layout, source_idx);
+
+    rdf_triple_buffer triples;
+    triples.reserve(record.triple_count);
+
+    for (std::uint64_t idx = record.first_triple;
+         idx < record.first_triple + record.triple_count; ++idx)
+    {
+        const auto triple = read_record<triple_record>(
+            snapshot, layout.triples_offset + idx * sizeof(triple_record));
+
+        triples.push_back({
+            read_term(snapshot, layout, triple.subject),
+            read_term(snapshot, layout, triple.predicate),
+            read_term(snapshot, layout, triple.object) });
+    }
+
+    return triples;
+}
+
+} // namespace common
@@ -0,0 +1,539 @@
+#include "common/native_storage.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+#include "common/rdf_term.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+using term_id = std::uint32_t;
+
+/** The statement node identifiers in the order of the permutation owning the key */
+using triple_key = std::array<term_id, 3>;
+
+/** The statement component positions (the order of the components within the triple_key) */
+constexpr std::size_t k_subject = 0;
+constexpr std::size_t k_predicate = 1;
+constexpr std::size_t k_object = 2;
+
+/** A sorted permutation of the encoded statements
+ *
+ * The order member lists the statement components in the key order, e.g. {object, subject,
+ *  predicate} for the OSP permutation. */
+struct triple_index
+{
+    std::array<std::size_t, 3> order;
+    std::vector<triple_key> keys;
+
+    [[nodiscard]] triple_key to_key(const triple_key& spo) const
+    {
+        return { spo[order[0]], spo[order[1]], spo[order[2]] };
+    }
+
+    [[nodiscard]] triple_key to_spo(const triple_key& key) const
+    {
+        triple_key spo {};
+        spo[order[0]] = key[0];
+        spo[order[1]] = key[1];
+        spo[order[2]] = key[2];
+        return spo;
+    }
+};
+
+class native_store;
+
+struct find_stream_ctx
+{
+    const native_store* store;
+    const triple_index* index;
+    std::size_t pos;
+    std::size_t end;
+    librdf_statement* current;
+};
+
+class native_store
+{
+public:
+    explicit native_store(librdf_world* world)
+        : m_world(world),
+          m_indexes {{
+              { { k_subject, k_predicate, k_object }, {} },
+              { { k_predicate, k_object, k_subject }, {} },
+              { { k_object, k_subject, k_predicate }, {} } }} {}
+
+    native_store(const native_store&) = delete;
+    native_store& operator=(const native_store&) = delete;
+
+    ~native_store()
+    {
+        for (librdf_node* node : m_nodes)
+        {
+            librdf_free_node(node);
+        }
+    }
+
+    int size()
+    {
+        sync_indexes();
+        return static_cast<int>(spo_index().keys.size());
+    }
+
+    void add(librdf_statement* statement)
+    {
+        m_pending.push_back({
+            intern(librdf_statement_get_subject(statement)),
+            intern(librdf_statement_get_predicate(statement)),
+            intern(librdf_statement_get_object(statement)) });
+    }
+
+    bool remove(librdf_statement* statement)
+    {
+        sync_indexes();
+
+        const std::optional<triple_key> spo = encode(statement);
+
+        if (!spo || !std::binary_search(spo_index().keys.begin(), spo_index().keys.end(), *spo))
+        {
+            return false;
+        }
+
+        for (triple_index& index : m_indexes)
+        {
+            const triple_key key = index.to_key(*spo);
+            index.keys.erase(std::lower_bound(index.keys.begin(), index.keys.end(), key));
+        }
+
+        return true;
+    }
+
+    bool contains(librdf_statement* statement)
+    {
+        sync_indexes();
+
+        const std::optional<triple_key> spo = encode(statement);
+
+        return (
+            spo && std::binary_search(spo_index().keys.begin(), spo_index().keys.end(), *spo));
+    }
+
+    /** Find the statements matching the pattern (all the statements for the null pattern)
+     *
+     * The returned stream is invalidated by any subsequent modification of the storage. */
+    librdf_stream* find(librdf_statement* pattern);
+
+    /** Create a new statement of the key (the caller takes the ownership) */
+    librdf_statement* new_statement(const triple_index& index, const triple_key& key) const
+    {
+        const triple_key spo = index.to_spo(key);
+
+        librdf_statement* statement = librdf_new_statement_from_nodes(
+            m_world,
+            librdf_new_node_from_node(m_nodes[spo[k_subject]]),
+            librdf_new_node_from_node(m_nodes[spo[k_predicate]]),
+            librdf_new_node_from_node(m_nodes[spo[k_object]]));
+
+        if (!statement)
+        {
+            throw common_exception(
+                common_exception::error_code::redland_unexpected_behavior,
+                "Failed to create a redland statement");
+        }
+
+        return statement;
+    }
+
+private:
+    triple_index& spo_index() { return m_indexes[0]; }
+
+    term_id intern(librdf_node* node)
+    {
+        const auto [term_it, inserted] = m_term_ids.try_emplace(
+            to_rdf_term(node), static_cast<term_id>(m_nodes.size()));
+
+        if (inserted)
+        {
+            if (m_nodes.size() >= std::numeric_limits<term_id>::max())
+            {
+                m_term_ids.erase(term_it);
+
+                throw common_exception(
+                    common_exception::error_code::data_size_error,
+                    "Too many distinct terms for the native storage");
+            }
+
+            m_nodes.push_back(librdf_new_node_from_node(node));
+        }
+
+        return term_it->second;
+    }
+
+    /** Get the identifier of an already interned node */
+    std::optional<term_id> lookup(librdf_node* node) const
+    {
+        const auto term_it = m_term_ids.find(to_rdf_term(node));
+
+        if (term_it == m_term_ids.end())
+        {
+            return std::nullopt;
+        }
+
+        return term_it->second;
+    }
+
+    std::optional<triple_key> encode(librdf_statement* statement) const
+    {
+        const auto subject = lookup(librdf_statement_get_subject(statement));
+        const auto predicate = lookup(librdf_statement_get_predicate(statement));
+        const auto object = lookup(librdf_statement_get_object(statement));
+
+        if (!subject || !predicate || !object)
+        {
+            return std::nullopt;
+        }
+
+        return triple_key { *subject, *predicate, *object };
+    }
+
+    /** Merge the statements added since the last lookup into the permutation arrays */
+    void sync_indexes()
+    {
+        if (m_pending.empty())
+        {
+            return;
+        }
+
+        std::sort(m_pending.begin(), m_pending.end());
+        m_pending.erase(std::unique(m_pending.begin(), m_pending.end()), m_pending.end());
+
+        // The statement set semantics: the already stored statements aren't added again
+        std::vector<triple_key> added;
+        added.reserve(m_pending.size());
+        std::set_difference(
+            m_pending.begin(), m_pending.end(),
+            spo_index().keys.begin(), spo_index().keys.end(),
+            std::back_inserter(added));
+        m_pending.clear();
+
+        for (triple_index& index : m_indexes)
+        {
+            const auto mid = static_cast<std::ptrdiff_t>(index.keys.size());
+
+            for (const triple_key& spo : added)
+            {
+                index.keys.push_back(index.to_key(spo));
+            }
+
+            std::sort(index.keys.begin() + mid, index.keys.end());
+            std::inplace_merge(index.keys.begin(), index.keys.begin() + mid, index.keys.end());
+        }
+
+        spdlog::debug(
+            "{}: Merged {} statements (total statements: {}, total terms: {})",
+            __func__, added.size(), spo_index().keys.size(), m_nodes.size());
+    }
+
+    librdf_world* m_world;
+    std::unordered_map<rdf_term, term_id, rdf_term_hash> m_term_ids;
+    std::vector<librdf_node*> m_nodes;
+    std::array<triple_index, 3> m_indexes;
+    std::vector<triple_key> m_pending;
+};
+
+//  The find stream methods
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+void free_current_statement(find_stream_ctx* ctx)
+{
+    if (ctx->current)
+    {
+        librdf_free_statement(ctx->current);
+        ctx->current = nullptr;
+    }
+}
+
+int find_stream_is_end(void* context)
+{
+    auto* ctx = static_cast<find_stream_ctx*>(context);
+    return (ctx->pos >= ctx->end ? 1 : 0);
+}
+
+int find_stream_next(void* context)
+{
+    auto* ctx = static_cast<find_stream_ctx*>(context);
+
+    free_current_statement(ctx);
+    ++ctx->pos;
+
+    return find_stream_is_end(context);
+}
+
+void* find_stream_get(void* context, int flags)
+{
+    auto* ctx = static_cast<find_stream_ctx*>(context);
+
+    if ((flags != LIBRDF_STREAM_GET_METHOD_GET_OBJECT) || (ctx->pos >= ctx->end))
+    {
+        // The storage doesn't support contexts
+        return nullptr;
+    }
+
+    if (!ctx->current)
+    {
+        try
+        {
+            ctx->current = ctx->store->new_statement(*ctx->index, ctx->index->keys[ctx->pos]);
+        }
+        catch (const common_exception& e)
+        {
+            spdlog::error("{}: {}", __func__, e.what());
+        }
+    }
+
+    return ctx->current;
+}
+
+void find_stream_finished(void* context)
+{
+    auto* ctx = static_cast<find_stream_ctx*>(context);
+
+    free_current_statement(ctx);
+
+    delete ctx;
+}
+
+librdf_stream* native_store::find(librdf_statement* pattern)
+{
+    sync_indexes();
+
+    // The pattern nodes in the SPO order (the null node is a wildcard)
+    std::array<librdf_node*, 3> nodes {};
+
+    if (pattern)
+    {
+        nodes = {
+            librdf_statement_get_subject(pattern),
+            librdf_statement_get_predicate(pattern),
+            librdf_statement_get_object(pattern) };
+    }
+
+    // Choose the permutation whose key starts with all the bound components. The subject and
+    //  object pair is the only combination requiring the OSP rather than the SPO permutation.
+    const triple_index* index = &m_indexes[0];
+
+    if (!nodes[k_subject] && nodes[k_predicate])
+    {
+        index = &m_indexes[1];
+    }
+    else if (nodes[k_object] && !nodes[k_predicate])
+    {
+        index = &m_indexes[2];
+    }
+
+    triple_key prefix {};
+    std::size_t prefix_size = 0;
+
+    for (const std::size_t component : index->order)
+    {
+        if (!nodes[component])
+        {
+            break;
+        }
+
+        const std::optional<term_id> id = lookup(nodes[component]);
+
+        if (!id)
+        {
+            // A node that was never stored can't match any statement
+            return librdf_new_empty_stream(m_world);
+        }
+
+        prefix[prefix_size++] = *id;
+    }
+
+    auto compare_prefix = [prefix_size](const triple_key& lhs, const triple_key& rhs) {
+        return std::lexicographical_compare(
+            lhs.begin(), lhs.begin() + static_cast<std::ptrdiff_t>(prefix_size),
+            rhs.begin(), rhs.begin() + static_cast<std::ptrdiff_t>(prefix_size));
+    };
+
+    const auto [first, last] = std::equal_range(
+        index->keys.begin(), index->keys.end(), prefix, compare_prefix);
+
+    auto* ctx = new find_stream_ctx {
+        this, index,
+        static_cast<std::size_t>(first - index->keys.begin()),
+        static_cast<std::size_t>(last - index->keys.begin()),
+        nullptr };
+
+    librdf_stream* stream = librdf_new_stream(
+        m_world, ctx,
+        find_stream_is_end, find_stream_next, find_stream_get, find_stream_finished);
+
+    if (!stream)
+    {
+        delete ctx;
+    }
+
+    return stream;
+}
+
+//  The storage factory methods
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+// The factory methods are called by the Redland C code, so no exception may leave them
+
+native_store* get_store(librdf_storage* storage)
+{
+    return static_cast<native_store*>(librdf_storage_get_instance(storage));
+}
+
+int native_storage_init(librdf_storage* storage, const char*, librdf_hash*)
+{
+    try
+    {
+        librdf_storage_set_instance(storage, new native_store(librdf_storage_get_world(storage)));
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}: {}", __func__, e.what());
+        return 1;
+    }
+}
+
+void native_storage_terminate(librdf_storage* storage)
+{
+    delete get_store(storage);
+}
+
+int native_storage_open(librdf_storage*, librdf_model*)
+{
+    return 0;
+}
+
+int native_storage_close(librdf_storage*)
+{
+    return 0;
+}
+
+int native_storage_size(librdf_storage* storage)
+{
+    return get_store(storage)->size();
+}
+
+int native_storage_add_statement(librdf_storage* storage, librdf_statement* statement)
+{
+    try
+    {
+        get_store(storage)->add(statement);
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}: {}", __func__, e.what());
+        return 1;
+    }
+}
+
+int native_storage_remove_statement(librdf_storage* storage, librdf_statement* statement)
+{
+    try
+    {
+        return (get_store(storage)->remove(statement) ? 0 : 1);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}: {}", __func__, e.what());
+        return 1;
+    }
+}
+
+int native_storage_contains_statement(librdf_storage* storage, librdf_statement* statement)
+{
+    try
+    {
+        return (get_store(storage)->contains(statement) ? 1 : 0);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}: {}", __func__, e.what());
+        return 0;
+    }
+}
+
+librdf_stream* native_storage_find_statements(
+    librdf_storage* storage, librdf_statement* statement)
+{
+    try
+    {
+        return get_store(storage)->find(statement);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}: {}", __func__, e.what());
+        return nullptr;
+    }
+}
+
+librdf_stream* native_storage_serialise(librdf_storage* storage)
+{
+    return native_storage_find_statements(storage, nullptr);
+}
+
+int native_storage_sync(librdf_storage*)
+{
+    return 0;
+}
+
+void native_storage_register_methods(librdf_storage_factory* factory)
+{
+    factory->version = LIBRDF_STORAGE_INTERFACE_VERSION;
+    factory->init = native_storage_init;
+    factory->terminate = native_storage_terminate;
+    factory->open = native_storage_open;
+    factory->close = native_storage_close;
+    factory->size = native_storage_size;
+    factory->add_statement = native_storage_add_statement;
+    factory->remove_statement = native_storage_remove_statement;
+    factory->contains_statement = native_storage_contains_statement;
+    factory->serialise = native_storage_serialise;
+    factory->find_statements = native_storage_find_statements;
+    factory->sync = native_storage_sync;
+}
+
+} // anonymous namespace
+
+void register_native_storage(librdf_world* world)
+{
+    const int error = librdf_storage_register_factory(
+        world, k_native_storage_name, "Native dictionary encoded, sorted triple storage",
+        native_storage_register_methods);
+
+    if (error)
+    {
+        spdlog::error("{}: Failed to register the native storage factory", __func__);
+
+        throw common_exception(
+            common_exception::error_code::redland_initialization_failed,
+            "Failed to register the native storage factory");
+    }
+
+    spdlog::debug("{}: Registered the native storage factory", __func__);
+}
+
+} // namespace common
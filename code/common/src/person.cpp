@@ -2,12 +2,13 @@
 
 #include <cassert>
 #include <chrono>
-#include <format>
 #include <sstream>
+#include <variant>
 
 #include <spdlog/spdlog.h>
 
 #include "common/common_exception.hpp"
+#include "common/typed_literal.hpp"
 
 namespace common
 {
@@ -125,33 +126,6 @@ void Person::print_state(std::ostream& os) const
 }
 
 
-#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 14)
-# error "g++-14 is required to use the std::chrono::parse function"
-#endif
-
-std::chrono::year_month_day convert_date(const std::string& raw)
-{
-    std::chrono::year_month_day result;
-
-    std::istringstream is{raw};
-    is >> std::chrono::parse("%F", result);
-
-    // is.fail() will return true when:
-    //  * the input format is not valid (%F stands for ISO-8601, so '01-02-2003' in not valid while
-    //    '2003-02-01' is valid);
-    //  * the successfully parsed input value doesn't represent a valid date, e.g. the month number
-    //     is out of range or the day is out of range for given year and month:
-    if (is.fail())
-    {
-        throw common_exception(
-            common_exception::error_code::data_format_error,
-            fmt::format("The birth date has unexpected format: '{}'", raw));
-    }
-
-    return result;
-}
-
-
 void extract_person_birth_date(Person& person, const data_row& row, const std::string& date_bn)
 {
     auto date_it = row.find(date_bn);
@@ -186,18 +160,18 @@ void extract_person_death_date(Person& person, const data_row& row, const std::s
 }
 
 
-Gender extract_person_gender(
-    const data_row& row, const std::string& gender_type_bn, std::vector<Note>& notes)
+namespace
 {
-    auto gender_it = row.find(gender_type_bn);
 
-    if (gender_it != row.end())
+Gender convert_gender(std::optional<std::string_view> gender_type, std::vector<Note>& notes)
+{
+    if (gender_type)
     {
-        if (gender_it->second == k_gender_uri_male)
+        if (*gender_type == k_gender_uri_male)
         {
             return Gender::Male;
         }
-        else if (gender_it->second == k_gender_uri_female)
+        else if (*gender_type == k_gender_uri_female)
         {
             return Gender::Female;
         }
@@ -214,6 +188,47 @@ Gender extract_person_gender(
     }
 }
 
+} // anonymous namespace
+
+
+Gender extract_person_gender(
+    const data_row& row, const std::string& gender_type_bn, std::vector<Note>& notes)
+{
+    auto gender_it = row.find(gender_type_bn);
+
+    return convert_gender(
+        ((gender_it != row.end())
+         ? std::optional<std::string_view>(gender_it->second) : std::nullopt),
+        notes);
+}
+
+
+Gender extract_person_gender(
+    const query_row_view& row, std::string_view gender_type_bn, std::vector<Note>& notes)
+{
+    return convert_gender(row.find(gender_type_bn), notes);
+}
+
+
+void extract_person_birth_date(
+    Person& person, const query_row_view& row, std::string_view date_bn)
+{
+    if (const std::optional<typed_cell> date = find_typed_value(row, date_bn))
+    {
+        person.birth_date = get_date(*date); // throws common_exception
+    }
+}
+
+
+void extract_person_death_date(
+    Person& person, const query_row_view& row, std::string_view date_bn)
+{
+    if (const std::optional<typed_cell> date = find_typed_value(row, date_bn))
+    {
+        person.death_date = get_date(*date); // throws common_exception
+    }
+}
+
 
 void extract_person_names(Person& person, const data_table& table) {
     for (data_row row : table) {
@@ -283,12 +298,12 @@ nlohmann::json person_to_json(const Person& person)
 
     if (person.birth_date)
     {
-        result["birth_date"] = std::format("{:%Y-%m-%d}", person.birth_date.value());
+        result["birth_date"] = to_string(person.birth_date.value());
     }
 
     if (person.death_date)
     {
-        result["death_date"] = std::format("{:%Y-%m-%d}", person.death_date.value());
+        result["death_date"] = to_string(person.death_date.value());
     }
 
     if (person.father)
@@ -364,4 +379,155 @@ nlohmann::json person_list_to_json(const std::vector<std::shared_ptr<Person>>& p
     return result;
 }
 
+namespace
+{
+
+/** @brief Write the person object
+ *
+ *  The members are written in the lexicographical order of their keys, i.e. the nlohmann::json
+ *   object order. The partner relation members (the children with the proband and the inferred
+ *   flag) are merged into the partner object, the same as by the person_to_json function. */
+void write_person_json_int(
+    json_writer& writer, const Person& person,
+    const std::vector<std::shared_ptr<Person>>* partner_children, std::optional<bool> inferred)
+{
+    const auto write_person_seq = [&writer](const std::vector<std::shared_ptr<Person>>& seq) {
+        writer.begin_array();
+
+        for (const auto& item : seq)
+        {
+            write_person_json_int(writer, *item, nullptr, std::nullopt);
+        }
+
+        writer.end_array();
+    };
+
+    writer.begin_object();
+
+    if (person.birth_date)
+    {
+        writer.key("birth_date");
+        writer.value(to_string(person.birth_date.value()));
+    }
+
+    const auto single_parent_children_it = person.children.find({});
+
+    if (partner_children)
+    {
+        writer.key("children");
+        write_person_seq(*partner_children);
+    }
+    else if (single_parent_children_it != person.children.end())
+    {
+        writer.key("children");
+        write_person_seq(single_parent_children_it->second);
+    }
+
+    if (person.death_date)
+    {
+        writer.key("death_date");
+        writer.value(to_string(person.death_date.value()));
+    }
+
+    if (person.father)
+    {
+        writer.key("father");
+        write_person_json_int(writer, *person.father, nullptr, std::nullopt);
+    }
+
+    if (person.gender == Gender::Male)
+    {
+        writer.key("gender");
+        writer.value(g_male);
+    }
+    else if (person.gender == Gender::Female)
+    {
+        writer.key("gender");
+        writer.value(g_female);
+    }
+
+    if (inferred)
+    {
+        writer.key("inferred");
+        writer.value(*inferred);
+    }
+
+    if (person.mother)
+    {
+        writer.key("mother");
+        write_person_json_int(writer, *person.mother, nullptr, std::nullopt);
+    }
+
+    const std::string full_name = person.get_full_name();
+
+    if (!full_name.empty())
+    {
+        writer.key("name");
+        writer.begin_object();
+        writer.key("full");
+        writer.value(full_name);
+
+        const std::string given_names = person.get_given_names();
+
+        if (!given_names.empty())
+        {
+            writer.key("given");
+            writer.value(given_names);
+        }
+
+        const std::string last_names = person.get_last_names();
+
+        if (!last_names.empty())
+        {
+            writer.key("last");
+            writer.value(last_names);
+        }
+
+        writer.end_object();
+    }
+
+    if (!person.notes().empty())
+    {
+        writer.key("notes");
+        writer.begin_array();
+
+        for (const auto& note : person.notes())
+        {
+            writer.embed(common::note_to_json(note));
+        }
+
+        writer.end_array();
+    }
+
+    if (!person.partners.empty())
+    {
+        writer.key("partners");
+        writer.begin_array();
+
+        for (const Person::PartnerRelation& relation : person.partners)
+        {
+            const auto children_it = person.children.find(*relation.partner);
+
+            write_person_json_int(
+                writer, *relation.partner,
+                (children_it != person.children.end() ? &children_it->second : nullptr),
+                relation.is_inferred);
+        }
+
+        writer.end_array();
+    }
+
+    writer.key("unique_path");
+    writer.value(person.get_unique_id());
+
+    writer.end_object();
+}
+
+} // anonymous namespace
+
+void write_person_json(json_writer& writer, const Person& person)
+{
+    write_person_json_int(writer, person, nullptr, std::nullopt);
+}
+
 } // namespace common
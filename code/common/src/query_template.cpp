@@ -0,0 +1,164 @@
+#include "common/query_template.hpp"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::string_view k_placeholder_open = "%{";
+constexpr std::string_view k_placeholder_close = "}";
+
+/** @brief Bind the query parameters and execute the query
+ *
+ *  @throws common_exception (input_contract_error) on invalid bindings (see query_template::bind)
+ *  @throws common_exception (redland_query_error) on query creation or execution failure */
+exec_query_result exec_bound_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings, const char* caller)
+{
+    const std::string query_text = query.bind(bindings); // throws common_exception
+
+    spdlog::debug("{}: The '{}' query: {}", caller, query.get_id(), query_text);
+
+    return exec_query(world, model, query_text, query.get_id());
+}
+
+} // anonymous namespace
+
+query_template::query_template(std::string query_id, std::string_view template_text)
+    : m_id(std::move(query_id)), m_text_size(0)
+{
+    std::size_t pos = 0;
+
+    while (pos < template_text.size())
+    {
+        const std::size_t open_pos = template_text.find(k_placeholder_open, pos);
+
+        if (open_pos == std::string_view::npos)
+        {
+            break;
+        }
+
+        const std::size_t name_pos = open_pos + k_placeholder_open.size();
+        const std::size_t close_pos = template_text.find(k_placeholder_close, name_pos);
+
+        if ((close_pos == std::string_view::npos) || (close_pos == name_pos))
+        {
+            throw common_exception(
+                common_exception::error_code::input_contract_error,
+                fmt::format(
+                    "Precondition failure: the '{}' query template placeholder at {} must be"
+                    " terminated and non-empty", m_id, open_pos));
+        }
+
+        m_segments.push_back({ std::string(template_text.substr(pos, open_pos - pos)), false });
+        m_segments.push_back({
+                std::string(template_text.substr(name_pos, close_pos - name_pos)), true });
+
+        pos = close_pos + k_placeholder_close.size();
+    }
+
+    m_segments.push_back({ std::string(template_text.substr(pos)), false });
+
+    for (const segment& seg : m_segments)
+    {
+        m_text_size += (seg.is_parameter ? 0 : seg.text.size());
+    }
+}
+
+std::string query_template::bind(const query_bindings& bindings) const
+{
+    std::string result;
+    result.reserve(m_text_size + 128);
+
+    for (const segment& seg : m_segments)
+    {
+        if (!seg.is_parameter)
+        {
+            result.append(seg.text);
+            continue;
+        }
+
+        const auto binding_it = bindings.find(seg.text);
+
+        if (binding_it == bindings.end())
+        {
+            throw common_exception(
+                common_exception::error_code::input_contract_error,
+                fmt::format(
+                    "Precondition failure: the '{}' parameter of the '{}' query must be bound",
+                    seg.text, m_id));
+        }
+
+        if (!is_valid_iri_ref(binding_it->second))
+        {
+            throw common_exception(
+                common_exception::error_code::input_contract_error,
+                fmt::format(
+                    "Precondition failure: {}='{}' must satisfy is_valid_iri_ref",
+                    seg.text, binding_it->second));
+        }
+
+        result.push_back('<');
+        result.append(binding_it->second);
+        result.push_back('>');
+    }
+
+    return result;
+}
+
+bool is_valid_iri_ref(std::string_view iri)
+{
+    // SPARQL 1.1 grammar: IRIREF ::= '<' ([^<>"{}|^`\]-[#x00-#x20])* '>'
+    constexpr std::string_view k_forbidden = "<>\"{}|^`\\";
+
+    if (iri.empty())
+    {
+        return false;
+    }
+
+    for (const char c : iri)
+    {
+        if ((static_cast<unsigned char>(c) <= 0x20) || (k_forbidden.find(c) != k_forbidden.npos))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+extract_data_table_result exec_templated_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings)
+{
+    exec_query_result res = exec_bound_query(world, model, query, bindings, __func__);
+
+    return extract_data_table(res->results);
+}
+
+column_table exec_templated_column_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings)
+{
+    exec_query_result res = exec_bound_query(world, model, query, bindings, __func__);
+
+    return extract_column_table(res->results); // throws common_exception
+}
+
+std::size_t visit_templated_query(
+    librdf_world* world, librdf_model* model, const query_template& query,
+    const query_bindings& bindings, const query_row_visitor& visitor)
+{
+    exec_query_result res = exec_bound_query(world, model, query, bindings, __func__);
+
+    return visit_query_results(res->results, visitor);
+}
+
+} // namespace common
@@ -0,0 +1,197 @@
+#include "common/rdf_term.hpp"
+
+#include <functional>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+const unsigned char* as_uchar_str(const std::string& str)
+{
+    return reinterpret_cast<const unsigned char*>(str.c_str());
+}
+
+std::string as_string(const unsigned char* str)
+{
+    return (str ? std::string(reinterpret_cast<const char*>(str)) : std::string());
+}
+
+librdf_node* new_literal_node(librdf_world* world, const rdf_term& term)
+{
+    if (term.datatype.empty())
+    {
+        return librdf_new_node_from_typed_literal(
+            world, as_uchar_str(term.value),
+            (term.language.empty() ? nullptr : term.language.c_str()), nullptr);
+    }
+
+    librdf_uri* datatype_uri = librdf_new_uri(world, as_uchar_str(term.datatype));
+
+    if (!datatype_uri)
+    {
+        return nullptr;
+    }
+
+    // A typed literal can't have the language tag, so the language is deliberately ignored here
+    librdf_node* node = librdf_new_node_from_typed_literal(
+        world, as_uchar_str(term.value), nullptr, datatype_uri);
+
+    // The node holds its own reference to the datatype uri
+    librdf_free_uri(datatype_uri);
+
+    return node;
+}
+
+} // anonymous namespace
+
+std::size_t rdf_term_hash::operator()(const rdf_term& term) const noexcept
+{
+    std::size_t seed = std::hash<std::string>{}(term.value);
+    seed ^= std::hash<std::string>{}(term.datatype) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<std::string>{}(term.language) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed ^ static_cast<std::size_t>(term.type);
+}
+
+rdf_term to_rdf_term(librdf_node* node)
+{
+    if (!node)
+    {
+        throw common_exception(
+            common_exception::error_code::input_contract_error,
+            "Precondition failure: node=nullptr must satisfy !nullptr");
+    }
+
+    rdf_term term;
+
+    if (librdf_node_is_resource(node))
+    {
+        term.type = rdf_term::kind::uri;
+        term.value = as_string(librdf_uri_as_string(librdf_node_get_uri(node)));
+    }
+    else if (librdf_node_is_literal(node))
+    {
+        term.type = rdf_term::kind::literal;
+        term.value = as_string(librdf_node_get_literal_value(node));
+
+        if (librdf_uri* datatype_uri = librdf_node_get_literal_value_datatype_uri(node))
+        {
+            term.datatype = as_string(librdf_uri_as_string(datatype_uri));
+        }
+
+        if (const char* language = librdf_node_get_literal_value_language(node))
+        {
+            term.language = language;
+        }
+    }
+    else if (librdf_node_is_blank(node))
+    {
+        term.type = rdf_term::kind::blank;
+        term.value = as_string(librdf_node_get_blank_identifier(node));
+    }
+    else
+    {
+        throw common_exception(
+            common_exception::error_code::redland_unexpected_behavior,
+            "Unexpected redland node type");
+    }
+
+    return term;
+}
+
+librdf_node* new_librdf_node(librdf_world* world, const rdf_term& term)
+{
+    librdf_node* node = nullptr;
+
+    switch (term.type)
+    {
+    case rdf_term::kind::uri:
+        node = librdf_new_node_from_uri_string(world, as_uchar_str(term.value));
+        break;
+    case rdf_term::kind::literal:
+        node = new_literal_node(world, term);
+        break;
+    case rdf_term::kind::blank:
+        node = librdf_new_node_from_blank_identifier(world, as_uchar_str(term.value));
+        break;
+    }
+
+    if (!node)
+    {
+        spdlog::error("{}: Failed to create a redland node ({})", __func__, term.value);
+
+        throw common_exception(
+            common_exception::error_code::redland_unexpected_behavior,
+            fmt::format("Failed to create a redland node: '{}'", term.value));
+    }
+
+    return node;
+}
+
+void scope_blank_node(rdf_term& term, std::string_view scope)
+{
+    if (term.type == rdf_term::kind::blank)
+    {
+        term.value = fmt::format("{}_{}", scope, term.value);
+    }
+}
+
+void add_rdf_triples(librdf_world* world, librdf_model* model, const rdf_triple_buffer& triples)
+{
+    spdlog::trace("{}: Entry checkpoint ({} triples)", __func__, triples.size());
+
+    for (const rdf_triple& triple : triples)
+    {
+        librdf_node* subject = new_librdf_node(world, triple.subject);
+        librdf_node* predicate = nullptr;
+        librdf_node* object = nullptr;
+
+        try
+        {
+            predicate = new_librdf_node(world, triple.predicate);
+            object = new_librdf_node(world, triple.object);
+        }
+        catch (const common_exception&)
+        {
+            librdf_free_node(subject);
+
+            if (predicate)
+            {
+                librdf_free_node(predicate);
+            }
+
+            throw;
+        }
+
+        // The statement takes the ownership of the nodes
+        librdf_statement* statement = librdf_new_statement_from_nodes(
+            world, subject, predicate, object);
+
+        if (!statement)
+        {
+            throw common_exception(
+                common_exception::error_code::redland_unexpected_behavior,
+                "Failed to create a redland statement");
+        }
+
+        const int add_error = librdf_model_add_statement(model, statement);
+        librdf_free_statement(statement);
+
+        if (add_error)
+        {
+            throw common_exception(
+                common_exception::error_code::redland_unexpected_behavior,
+                fmt::format(
+                    "Failed to add a statement to the redland model (subject: '{}')",
+                    triple.subject.value));
+        }
+    }
+}
+
+} // namespace common
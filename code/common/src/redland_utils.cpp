@@ -1,12 +1,17 @@
 #include "common/redland_utils.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <condition_variable>
+#include <exception>
 #include <iostream>
 #include <unordered_set>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <map>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -14,6 +19,8 @@
 #include <tabulate/tabulate.hpp>
 
 #include "common/common_exception.hpp"
+#include "common/file_fingerprint.hpp"
+#include "common/native_storage.hpp"
 
 // ---[ Fmt Library Extensions ]---------------------------------------------------------------- //
 
@@ -118,7 +125,7 @@ scoped_redland_ctx create_redland_ctx()
     return { new redland_context(), release_redland_ctx };
 }
 
-void initialize_redland_ctx(scoped_redland_ctx& ctx)
+void initialize_redland_ctx(scoped_redland_ctx& ctx, storage_backend backend)
 {
     ctx->world = librdf_new_world();
 
@@ -138,8 +145,16 @@ void initialize_redland_ctx(scoped_redland_ctx& ctx)
 
     spdlog::debug("{}: Initialized the redland world", __func__);
 
+    const char* storage_name = "memory";
+
+    if (backend == storage_backend::native)
+    {
+        register_native_storage(ctx->world); // throws common_exception on registration failure
+        storage_name = k_native_storage_name;
+    }
+
     // https://librdf.org/docs/api/redland-storage.html#librdf-new-storage
-    ctx->storage = librdf_new_storage(ctx->world, "memory", nullptr, nullptr);
+    ctx->storage = librdf_new_storage(ctx->world, storage_name, nullptr, nullptr);
 
     if (!ctx->storage)
     {
@@ -150,7 +165,7 @@ void initialize_redland_ctx(scoped_redland_ctx& ctx)
             "Failed to create a new redland storage");
     }
 
-    spdlog::debug("{}: Created a new redland storage", __func__);
+    spdlog::debug("{}: Created a new redland storage ({})", __func__, storage_name);
 
     // https://librdf.org/docs/api/redland-model.html#librdf-new-model
     ctx->model = librdf_new_model(ctx->world, ctx->storage, nullptr);
@@ -167,6 +182,28 @@ void initialize_redland_ctx(scoped_redland_ctx& ctx)
     spdlog::debug("{}: Created a new redland model", __func__);
 }
 
+std::vector<scoped_redland_ctx> create_redland_ctx_copies(
+    std::size_t count, storage_backend backend)
+{
+    std::vector<scoped_redland_ctx> result;
+    result.reserve(count);
+
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        scoped_redland_ctx& ctx = result.emplace_back(create_redland_ctx());
+        initialize_redland_ctx(ctx, backend); // throws common_exception
+    }
+
+    return result;
+}
+
+void fill_redland_ctx_copy(redland_context& ctx, const rdf_triple_buffer& triples)
+{
+    add_rdf_triples(ctx.world, ctx.model, triples); // throws common_exception
+
+    spdlog::debug("{}: Copied {} statements", __func__, triples.size());
+}
+
 
 namespace
 {
@@ -252,6 +289,348 @@ void load_rdf_set(librdf_world* world, librdf_model* model, const input_files& i
     }
 }
 
+namespace
+{
+    /** The parsing context owned by a single worker thread of the parse_rdf_set function */
+    struct parse_worker_ctx
+    {
+        librdf_world*  world;
+        librdf_parser* parser;
+        librdf_uri*    base_uri;
+        /** Set by the world logger when an error is reported (e.g. a syntax error of the file) */
+        bool           error_logged;
+    };
+
+    /** The statements parsed from a single input file (see parsed_rdf_file_cb) */
+    struct parsed_rdf_file
+    {
+        rdf_triple_buffer triples;
+        bool              complete;
+    };
+
+    /** Log the message (see redland_log_cb) and flag the errors in the parse_worker_ctx
+     *
+     * The parser stream just ends when the parser fails, so the logged error is the only way to
+     *  tell the truncated file from the complete one. */
+    int parse_worker_log_cb(void* user_data, librdf_log_message* message)
+    {
+        const librdf_log_level level = librdf_log_message_level(message);
+
+        if ((level == LIBRDF_LOG_ERROR) || (level == LIBRDF_LOG_FATAL))
+        {
+            static_cast<parse_worker_ctx*>(user_data)->error_logged = true;
+        }
+
+        return redland_log_cb(nullptr, message);
+    }
+
+    void release_parse_worker_ctx(parse_worker_ctx* ctx)
+    {
+        if (ctx->base_uri)
+        {
+            librdf_free_uri(ctx->base_uri);
+        }
+
+        if (ctx->parser)
+        {
+            librdf_free_parser(ctx->parser);
+        }
+
+        if (ctx->world)
+        {
+            librdf_free_world(ctx->world);
+        }
+
+        spdlog::debug("Released the parse worker context");
+
+        delete ctx;
+    }
+
+    using scoped_parse_worker_ctx =
+        std::unique_ptr<parse_worker_ctx, decltype(&release_parse_worker_ctx)>;
+
+    /** Create a parsing context of a single worker thread
+     *
+     * The function is expected to be called from the thread creating the workers, as the world
+     *  construction isn't guaranteed to be thread safe. */
+    scoped_parse_worker_ctx create_parse_worker_ctx()
+    {
+        scoped_parse_worker_ctx ctx = { new parse_worker_ctx(), release_parse_worker_ctx };
+
+        ctx->world = librdf_new_world();
+
+        if (!ctx->world)
+        {
+            spdlog::error("{}: Failed to create a new redland world", __func__);
+
+            throw common_exception(
+                common_exception::error_code::redland_initialization_failed,
+                "Failed to create a new redland world for a parse worker");
+        }
+
+        librdf_world_set_logger(ctx->world, ctx.get(), parse_worker_log_cb);
+        librdf_world_open(ctx->world);
+
+        ctx->parser = librdf_new_parser(ctx->world, "turtle", nullptr, nullptr);
+
+        if (!ctx->parser)
+        {
+            spdlog::error("{}: Failed to create a redland parser", __func__);
+
+            throw common_exception(
+                common_exception::error_code::redland_initialization_failed,
+                "Failed to create a redland parser for a parse worker");
+        }
+
+        ctx->base_uri = librdf_new_uri(
+            ctx->world, reinterpret_cast<const unsigned char*>("https://aurochsoft.com/"));
+
+        if (!ctx->base_uri)
+        {
+            spdlog::error("{}: Failed to create the Base URI", __func__);
+
+            throw common_exception(
+                common_exception::error_code::redland_initialization_failed,
+                "Failed to create the base uri for a parse worker");
+        }
+
+        spdlog::debug("{}: Created a parse worker context", __func__);
+
+        return ctx;
+    }
+
+    parsed_rdf_file parse_rdf_file(
+        parse_worker_ctx& ctx, const std::filesystem::path& input_file_path)
+    {
+        parsed_rdf_file result { .triples={}, .complete=false };
+
+        FILE* input_file = fopen(input_file_path.c_str(), "r");
+
+        if (!input_file)
+        {
+            spdlog::error("{}: Failed to open the '{}' file", __func__, input_file_path);
+
+            return result;
+        }
+
+        ctx.error_logged = false;
+
+        librdf_stream* stream = librdf_parser_parse_file_handle_as_stream(
+            ctx.parser, input_file, 0, ctx.base_uri);
+
+        if (!stream)
+        {
+            fclose(input_file);
+
+            spdlog::error("{}: Failed to parse the '{}' input file", __func__, input_file_path);
+
+            return result;
+        }
+
+        const std::string blank_scope =
+            fmt::format("f{:016x}", hash_bytes(input_file_path.string()));
+
+        for (; !librdf_stream_end(stream); librdf_stream_next(stream))
+        {
+            librdf_statement* statement = librdf_stream_get_object(stream);
+
+            rdf_triple& triple = result.triples.emplace_back(
+                rdf_triple{
+                    to_rdf_term(librdf_statement_get_subject(statement)),
+                    to_rdf_term(librdf_statement_get_predicate(statement)),
+                    to_rdf_term(librdf_statement_get_object(statement))
+                });
+
+            scope_blank_node(triple.subject, blank_scope);
+            scope_blank_node(triple.object, blank_scope);
+        }
+
+        librdf_free_stream(stream);
+        fclose(input_file);
+
+        if (ctx.error_logged)
+        {
+            spdlog::error(
+                "{}: Failed to parse the '{}' input file ({} statements parsed before the error)",
+                __func__, input_file_path, result.triples.size());
+
+            return result;
+        }
+
+        result.complete = true;
+
+        spdlog::info(
+            "{}: Successfully parsed the '{}' input file ({} statements)",
+            __func__, input_file_path, result.triples.size());
+
+        return result;
+    }
+
+    unsigned int resolve_thread_count(unsigned int thread_count, std::size_t file_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::max(1U, std::thread::hardware_concurrency());
+        }
+
+        return static_cast<unsigned int>(
+            std::min<std::size_t>(thread_count, std::max<std::size_t>(file_count, 1)));
+    }
+}
+
+void parse_rdf_set(
+    const input_files& input_file_paths, unsigned int thread_count,
+    const parsed_rdf_file_cb& callback)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    const std::vector<std::filesystem::path> paths(
+        input_file_paths.begin(), input_file_paths.end());
+    const unsigned int worker_count = resolve_thread_count(thread_count, paths.size());
+
+    spdlog::info(
+        "{}: Parsing {} input file{} using {} thread{}",
+        __func__, paths.size(), (paths.size() == 1 ? "" : "s"),
+        worker_count, (worker_count == 1 ? "" : "s"));
+
+    // The worker contexts are created up front by the calling thread (see create_parse_worker_ctx)
+    std::vector<scoped_parse_worker_ctx> worker_ctxs;
+    worker_ctxs.reserve(worker_count);
+
+    for (unsigned int i = 0; i < worker_count; ++i)
+    {
+        worker_ctxs.push_back(create_parse_worker_ctx());
+    }
+
+    std::vector<std::optional<parsed_rdf_file>> parsed_slots(paths.size());
+    std::mutex slots_mutex;
+    std::condition_variable slots_cv;
+    std::size_t next_file_idx = 0;
+    std::exception_ptr failure;
+    bool stop_flag = false;
+
+    auto worker_fn = [&](parse_worker_ctx* ctx) {
+        try
+        {
+            while (true)
+            {
+                std::size_t file_idx = 0;
+
+                {
+                    std::lock_guard<std::mutex> lock(slots_mutex);
+
+                    if (stop_flag || next_file_idx >= paths.size())
+                    {
+                        return;
+                    }
+
+                    file_idx = next_file_idx++;
+                }
+
+                parsed_rdf_file parsed = parse_rdf_file(*ctx, paths[file_idx]);
+
+                {
+                    std::lock_guard<std::mutex> lock(slots_mutex);
+                    parsed_slots[file_idx] = std::move(parsed);
+                }
+
+                slots_cv.notify_all();
+            }
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(slots_mutex);
+
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+
+                stop_flag = true;
+            }
+
+            slots_cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+
+    for (const auto& ctx : worker_ctxs)
+    {
+        workers.emplace_back(worker_fn, ctx.get());
+    }
+
+    // Deliver the parsed buffers in the input file order, as soon as they become available
+    for (std::size_t file_idx = 0; file_idx < paths.size(); ++file_idx)
+    {
+        parsed_rdf_file parsed { .triples={}, .complete=false };
+
+        {
+            std::unique_lock<std::mutex> lock(slots_mutex);
+            slots_cv.wait(
+                lock, [&] { return parsed_slots[file_idx].has_value() || stop_flag; });
+
+            if (!parsed_slots[file_idx].has_value())
+            {
+                break;
+            }
+
+            parsed = std::move(parsed_slots[file_idx].value());
+            parsed_slots[file_idx].reset();
+        }
+
+        try
+        {
+            callback(file_idx, paths[file_idx], std::move(parsed.triples), parsed.complete);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(slots_mutex);
+
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+
+            stop_flag = true;
+
+            break;
+        }
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+void load_rdf_set(
+    librdf_world* world, librdf_model* model, const input_files& input_file_paths,
+    unsigned int thread_count)
+{
+    if (resolve_thread_count(thread_count, input_file_paths.size()) <= 1)
+    {
+        load_rdf_set(world, model, input_file_paths);
+
+        return;
+    }
+
+    parse_rdf_set(
+        input_file_paths, thread_count,
+        [world, model](
+            std::size_t, const std::filesystem::path&, rdf_triple_buffer&& triples, bool) {
+            // The statements parsed before a parse error are kept, the same as by load_rdf
+            add_rdf_triples(world, model, triples);
+        });
+}
+
 
 void release_exec_query_ctx(exec_query_ctx* ctx)
 {
@@ -519,6 +898,169 @@ void print_data_table(const extract_data_table_result& data_table) {
 }
 
 
+std::optional<std::size_t> query_row_view::find_index(std::string_view binding_name) const
+{
+    for (std::size_t idx = 0; idx < m_names.size(); ++idx)
+    {
+        if (m_names[idx] == binding_name)
+        {
+            return idx;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string_view> query_row_view::find(std::string_view binding_name) const
+{
+    const std::optional<std::size_t> idx = find_index(binding_name);
+
+    return (idx ? m_values[*idx] : std::nullopt);
+}
+
+std::string_view query_row_view::get_req(std::string_view binding_name) const
+{
+    const std::optional<std::string_view> value = find(binding_name);
+
+    if (!value)
+    {
+        throw common_exception(
+            common_exception::error_code::binding_not_found,
+            fmt::format("The '{}' binding not found in the result row", binding_name));
+    }
+
+    return *value;
+}
+
+namespace
+{
+
+/** @brief Get the borrowed string form of the node (valid as long as the node is alive) */
+std::string_view get_node_view(librdf_node* node)
+{
+    std::size_t length = 0;
+    const unsigned char* value = nullptr;
+
+    if (librdf_node_is_literal(node))
+    {
+        value = librdf_node_get_literal_value_as_counted_string(node, &length);
+    }
+    else if (librdf_node_is_resource(node))
+    {
+        value = librdf_uri_as_counted_string(librdf_node_get_uri(node), &length);
+    }
+    else if (librdf_node_is_blank(node))
+    {
+        value = librdf_node_get_counted_blank_identifier(node, &length);
+    }
+    else
+    {
+        throw common_exception(
+            common_exception::error_code::redland_unexpected_behavior,
+            "Unexpected redland node type");
+    }
+
+    return { reinterpret_cast<const char*>(value), length };
+}
+
+/** @brief Get the borrowed datatype uri of the typed literal node (empty for the other nodes) */
+std::string_view get_node_datatype_view(librdf_node* node)
+{
+    if (!librdf_node_is_literal(node))
+    {
+        return {};
+    }
+
+    librdf_uri* datatype = librdf_node_get_literal_value_datatype_uri(node);
+
+    if (!datatype)
+    {
+        return {};
+    }
+
+    std::size_t length = 0;
+    const unsigned char* value = librdf_uri_as_counted_string(datatype, &length);
+
+    return { reinterpret_cast<const char*>(value), length };
+}
+
+} // anonymous namespace
+
+std::size_t visit_query_results(librdf_query_results* results, const query_row_visitor& visitor)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    assert(results);
+
+    const int binding_count = librdf_query_results_get_bindings_count(results);
+
+    if (binding_count < 0)
+    {
+        spdlog::error(
+            "{}: Couldn't retrieve the number of bound variables. The"
+            " librdf_query_results_get_bindings_count returned a negative number ({})",
+            __func__, binding_count);
+
+        return 0;
+    }
+
+    std::vector<std::string_view> names;
+    std::vector<librdf_node*> nodes(binding_count, nullptr);
+    std::vector<std::optional<std::string_view>> values(binding_count);
+    std::vector<std::string_view> datatypes(binding_count);
+
+    names.reserve(binding_count);
+
+    for (int idx = 0; idx < binding_count; ++idx)
+    {
+        names.emplace_back(librdf_query_results_get_binding_name(results, idx));
+    }
+
+    const auto release_nodes = [&nodes]() {
+        for (librdf_node*& node : nodes)
+        {
+            if (node)
+            {
+                librdf_free_node(node);
+                node = nullptr;
+            }
+        }
+    };
+
+    std::size_t row_count = 0;
+
+    try
+    {
+        for (; !librdf_query_results_finished(results); librdf_query_results_next(results))
+        {
+            for (int idx = 0; idx < binding_count; ++idx)
+            {
+                // The caller takes the ownership of the returned node
+                nodes[idx] = librdf_query_results_get_binding_value(results, idx);
+                values[idx] = (nodes[idx]
+                               ? std::optional<std::string_view>(get_node_view(nodes[idx]))
+                               : std::nullopt);
+                datatypes[idx] = (nodes[idx] ? get_node_datatype_view(nodes[idx]) : "");
+            }
+
+            visitor(query_row_view(names, values, datatypes));
+
+            release_nodes();
+            ++row_count;
+        }
+    }
+    catch (...)
+    {
+        release_nodes();
+
+        throw;
+    }
+
+    spdlog::debug("{}: Visited {} rows", __func__, row_count);
+
+    return row_count;
+}
+
 data_row::const_iterator get_binding_value_req(
     const data_row& row, const std::string& binding_name)
 {
@@ -0,0 +1,132 @@
+#include "common/source_index.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace common
+{
+
+void source_index::add_source(
+    const std::filesystem::path& source_path, const rdf_triple_buffer& triples)
+{
+    const source_id id = add_source_path(source_path);
+
+    for (const rdf_triple& triple : triples)
+    {
+        if (triple.subject.type == rdf_term::kind::uri)
+        {
+            add_subject(id, triple.subject.value);
+        }
+    }
+}
+
+void source_index::add_source(
+    const std::filesystem::path& source_path, std::span<const std::string> subject_uris)
+{
+    const source_id id = add_source_path(source_path);
+
+    for (const std::string& uri : subject_uris)
+    {
+        add_subject(id, uri);
+    }
+}
+
+source_index::source_id source_index::add_source_path(const std::filesystem::path& source_path)
+{
+    m_source_paths.push_back(source_path);
+
+    return static_cast<source_id>(m_source_paths.size() - 1);
+}
+
+void source_index::add_subject(source_id id, const std::string& subject_uri)
+{
+    auto it = m_resource_sources.find(subject_uri);
+
+    if (it == m_resource_sources.end())
+    {
+        it = m_resource_sources.emplace(subject_uri, std::vector<source_id>()).first;
+    }
+
+    // The statements of a source are added together, so checking the last one is enough
+    if (it->second.empty() || (it->second.back() != id))
+    {
+        it->second.push_back(id);
+    }
+}
+
+file_set source_index::get_sources(std::string_view resource_uri) const
+{
+    file_set result;
+
+    const auto it = m_resource_sources.find(resource_uri);
+
+    if (it != m_resource_sources.end())
+    {
+        for (const source_id id : it->second)
+        {
+            result.insert(m_source_paths[id]);
+        }
+    }
+
+    return result;
+}
+
+std::map<std::string, file_set, std::less<>> source_index::intersect(
+    std::vector<std::string> resource_uris) const
+{
+    std::sort(resource_uris.begin(), resource_uris.end());
+
+    std::map<std::string, file_set, std::less<>> result;
+
+    auto uri_it = resource_uris.cbegin();
+    auto subject_it = m_resource_sources.cbegin();
+
+    while ((uri_it != resource_uris.cend()) && (subject_it != m_resource_sources.cend()))
+    {
+        if (*uri_it < subject_it->first)
+        {
+            ++uri_it;
+        }
+        else if (subject_it->first < *uri_it)
+        {
+            ++subject_it;
+        }
+        else
+        {
+            file_set& sources = result.emplace_hint(result.end(), *uri_it, file_set())->second;
+
+            for (const source_id id : subject_it->second)
+            {
+                sources.insert(sources.end(), m_source_paths[id]);
+            }
+
+            // A duplicate of the uri (if any) is skipped by the next iteration
+            ++uri_it;
+            ++subject_it;
+        }
+    }
+
+    return result;
+}
+
+source_index build_source_index(const model_snapshot& snapshot)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    source_index result;
+
+    for (std::size_t idx = 0; idx < get_snapshot_source_count(snapshot); ++idx)
+    {
+        result.add_source(
+            get_snapshot_source_path(snapshot, idx), read_model_snapshot_source(snapshot, idx));
+    }
+
+    spdlog::debug(
+        "{}: Indexed {} resources described by {} source files", __func__,
+        result.get_resource_count(), result.get_source_count());
+
+    return result;
+}
+
+} // namespace common
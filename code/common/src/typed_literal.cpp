@@ -0,0 +1,164 @@
+#include "common/typed_literal.hpp"
+
+#include <charconv>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include "common/common_exception.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+[[noreturn]] void throw_invalid_literal(std::string_view datatype, std::string_view lexical)
+{
+    throw common_exception(
+        common_exception::error_code::data_format_error,
+        fmt::format("Invalid {} literal: '{}'", datatype, lexical));
+}
+
+typed_cell convert_boolean_literal(std::string_view lexical)
+{
+    return parse_xsd_boolean(lexical);
+}
+
+typed_cell convert_date_literal(std::string_view lexical)
+{
+    const std::optional<partial_date> result = parse_iso_date(lexical);
+
+    if (!result)
+    {
+        throw_invalid_literal(k_xsd_date, lexical);
+    }
+
+    return *result;
+}
+
+typed_cell convert_integer_literal(std::string_view lexical)
+{
+    return parse_xsd_integer(lexical);
+}
+
+} // anonymous namespace
+
+const literal_converter_lut& get_default_literal_converters()
+{
+    static const literal_converter_lut lut = {
+        { std::string(k_xsd_boolean), &convert_boolean_literal },
+        { std::string(k_xsd_date), &convert_date_literal },
+        { std::string(k_xsd_integer), &convert_integer_literal },
+        { std::string(k_xsd_int), &convert_integer_literal },
+        { std::string(k_xsd_long), &convert_integer_literal }
+    };
+
+    return lut;
+}
+
+typed_cell convert_literal(
+    std::string_view lexical, std::string_view datatype, const literal_converter_lut& lut)
+{
+    if (datatype.empty())
+    {
+        return lexical;
+    }
+
+    const auto converter_it = lut.find(datatype);
+
+    return (converter_it != lut.end() ? converter_it->second(lexical) : typed_cell(lexical));
+}
+
+std::optional<typed_cell> find_typed_value(
+    const query_row_view& row, std::string_view binding_name, const literal_converter_lut& lut)
+{
+    const std::optional<std::size_t> idx = row.find_index(binding_name);
+
+    if (!idx)
+    {
+        return std::nullopt;
+    }
+
+    const std::optional<std::string_view> value = row.get_value(*idx);
+
+    if (!value)
+    {
+        return std::nullopt;
+    }
+
+    return convert_literal(*value, row.get_datatype(*idx), lut); // throws common_exception
+}
+
+bool parse_xsd_boolean(std::string_view lexical)
+{
+    if ((lexical == "true") || (lexical == "1"))
+    {
+        return true;
+    }
+    else if ((lexical == "false") || (lexical == "0"))
+    {
+        return false;
+    }
+
+    throw_invalid_literal(k_xsd_boolean, lexical);
+}
+
+std::int64_t parse_xsd_integer(std::string_view lexical)
+{
+    std::string_view digits = lexical;
+
+    // The std::from_chars function doesn't accept the leading plus sign
+    if (!digits.empty() && (digits.front() == '+'))
+    {
+        digits.remove_prefix(1);
+    }
+
+    std::int64_t result = 0;
+    const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+
+    if (digits.empty() || (ec != std::errc()) || (end != digits.data() + digits.size()))
+    {
+        throw_invalid_literal(k_xsd_integer, lexical);
+    }
+
+    return result;
+}
+
+bool get_boolean(const typed_cell& cell)
+{
+    if (const bool* value = std::get_if<bool>(&cell))
+    {
+        return *value;
+    }
+    else if (const std::int64_t* value = std::get_if<std::int64_t>(&cell))
+    {
+        return (*value != 0);
+    }
+    else if (const std::string_view* value = std::get_if<std::string_view>(&cell))
+    {
+        return parse_xsd_boolean(*value); // throws common_exception
+    }
+
+    throw common_exception(
+        common_exception::error_code::data_format_error,
+        "The date value can't be interpreted as boolean");
+}
+
+partial_date get_date(const typed_cell& cell)
+{
+    if (const auto* value = std::get_if<partial_date>(&cell))
+    {
+        return *value;
+    }
+    else if (const std::string_view* value = std::get_if<std::string_view>(&cell))
+    {
+        return convert_date(*value); // throws common_exception
+    }
+
+    throw common_exception(
+        common_exception::error_code::data_format_error,
+        "The boolean or integer value can't be interpreted as date");
+}
+
+} // namespace common
@@ -32,6 +32,10 @@ void insert_uuu_statement(
     librdf_world* world, librdf_model* model,
     const char* subject, const char* predicate, const char* object);
 
+void remove_uuu_statement(
+    librdf_world* world, librdf_model* model,
+    const char* subject, const char* predicate, const char* object);
+
 } // namespace test::tools
 
 #endif // !defined TEST_TOOLS_REDLAND_HPP
@@ -0,0 +1,163 @@
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/column_table.hpp"
+#include "common/common_exception.hpp"
+#include "common/query_template.hpp"
+#include "common/redland_utils.hpp"
+#include "test/tools/redland.hpp"
+
+
+//  The string_arena class tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_string_arena
+{
+
+TEST(StringArena, StableViews)
+{
+    common::string_arena arena(16);
+    std::vector<std::string_view> views;
+
+    for (int idx = 0; idx < 100; ++idx)
+    {
+        views.emplace_back(arena.store("value-" + std::to_string(idx)));
+    }
+
+    // A value exceeding the block size gets its own block
+    const std::string long_value(100, 'x');
+    const std::string_view long_view = arena.store(long_value);
+
+    for (int idx = 0; idx < 100; ++idx)
+    {
+        EXPECT_EQ(views[idx], "value-" + std::to_string(idx));
+    }
+
+    EXPECT_EQ(long_view, long_value);
+    EXPECT_NE(long_view.data(), long_value.data());
+    EXPECT_TRUE(arena.store("").empty());
+}
+
+// The moved-from arena is left empty and the values stored into it get a new block
+TEST(StringArena, MovedFromArena)
+{
+    common::string_arena arena(16);
+    const std::string_view view = arena.store("value");
+
+    common::string_arena moved_arena(std::move(arena));
+
+    EXPECT_EQ(view, "value");
+    EXPECT_EQ(moved_arena.get_capacity(), 16);
+    EXPECT_EQ(arena.get_capacity(), 0); // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(arena.store("other"), "other"); // NOLINT(bugprone-use-after-move)
+
+    common::string_arena assigned_arena;
+    assigned_arena = std::move(moved_arena);
+
+    EXPECT_EQ(assigned_arena.get_capacity(), 16);
+    EXPECT_EQ(moved_arena.store("next"), "next"); // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(view, "value");
+}
+
+} // namespace test::suite_string_arena
+
+//  The column_table class tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_column_table
+{
+
+TEST(ColumnTable, AppendAndAccess)
+{
+    common::column_table table({ "a", "b" });
+
+    EXPECT_TRUE(table.empty());
+
+    std::string transient = "A1";
+    const std::optional<std::string_view> row1[] = { transient, std::nullopt };
+    table.append_row(row1);
+    transient = "XX"; // The table is expected to hold copies of the values
+
+    const std::optional<std::string_view> row2[] = { "A2", "B2" };
+    table.append_row(row2);
+
+    ASSERT_EQ(table.get_row_count(), 2);
+    ASSERT_EQ(table.get_column_count(), 2);
+
+    const common::column_table::column_index a_col = table.get_column_req("a");
+    const common::column_table::column_index b_col = table.get_column_req("b");
+
+    EXPECT_EQ(table.get(0, a_col), "A1");
+    EXPECT_EQ(table.get(0, b_col), std::nullopt);
+    EXPECT_EQ(table.get_req(1, b_col), "B2");
+    EXPECT_EQ(table.get_column(a_col).size(), 2);
+
+    EXPECT_FALSE(table.find_column("c").has_value());
+    EXPECT_THROW({ std::ignore = table.get_column_req("c"); }, common::common_exception);
+    EXPECT_THROW({ std::ignore = table.get_req(0, b_col); }, common::common_exception);
+
+    const std::optional<std::string_view> short_row[] = { "A3" };
+    EXPECT_THROW({ table.append_row(short_row); }, common::common_exception);
+
+    const common::data_table expected = {
+        { { "a", "A1" } },
+        { { "a", "A2" }, { "b", "B2" } }
+    };
+
+    EXPECT_EQ(table.to_data_table(), expected);
+}
+
+TEST(ColumnTable, ExtractQueryResults)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P3");
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P2", "urn:spouse", "urn:P4");
+
+    const common::query_template query("test", R"(
+        SELECT ?o ?spouse
+        WHERE {
+            %{s} <urn:parent> ?o .
+            OPTIONAL { ?o <urn:spouse> ?spouse }
+        }
+        ORDER BY ?o)");
+
+    const common::column_table table = common::exec_templated_column_query(
+        ctx->world, ctx->model, query, { { "s", "urn:P1" } });
+
+    ASSERT_EQ(table.get_row_count(), 2);
+
+    const auto spouse_col = table.get_column_req("spouse");
+
+    EXPECT_EQ(table.get(0, spouse_col), "urn:P4");
+    EXPECT_EQ(table.get(1, spouse_col), std::nullopt);
+    EXPECT_EQ(
+        common::extract_resource_uri_seq(table, "o"),
+        (std::vector<std::string>{ "urn:P2", "urn:P3" }));
+
+    // The materialized and the column representations are expected to be equivalent
+    const common::extract_data_table_result data_tuple = common::exec_templated_query(
+        ctx->world, ctx->model, query, { { "s", "urn:P1" } });
+
+    EXPECT_EQ(table.to_data_table(), std::get<1>(data_tuple));
+
+    // The head of an empty result is still available
+    const common::column_table empty_table = common::exec_templated_column_query(
+        ctx->world, ctx->model, query, { { "s", "urn:P9" } });
+
+    EXPECT_TRUE(empty_table.empty());
+    EXPECT_TRUE(empty_table.find_column("spouse").has_value());
+}
+
+} // namespace test::suite_column_table
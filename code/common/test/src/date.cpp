@@ -0,0 +1,129 @@
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common/common_exception.hpp"
+#include "common/date.hpp"
+#include "test/tools/gtest.hpp"
+
+using namespace std::chrono_literals;
+
+
+//  The parse_iso_date function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_parse_iso_date
+{
+
+struct Param
+{
+    const char* case_name;
+    std::string raw;
+    std::optional<common::partial_date> expected_date;
+    /* The expected to_string result (only checked for the valid dates) */
+    std::string expected_string;
+};
+
+class Date_ParseIsoDate : public ::testing::TestWithParam<Param> {};
+
+TEST_P(Date_ParseIsoDate, Cases)
+{
+    const Param& param = GetParam();
+
+    const std::optional<common::partial_date> actual_date = common::parse_iso_date(param.raw);
+
+    EXPECT_EQ(actual_date, param.expected_date);
+
+    if (param.expected_date)
+    {
+        ASSERT_TRUE(actual_date.has_value());
+        EXPECT_EQ(common::to_string(*actual_date), param.expected_string);
+        EXPECT_EQ(common::convert_date(param.raw), *param.expected_date);
+    }
+    else
+    {
+        EXPECT_THROW({ common::convert_date(param.raw); }, common::common_exception);
+    }
+}
+
+const std::vector<Param> g_params{
+    {
+        .case_name="Complete",
+        .raw="2003-02-01",
+        .expected_date=common::partial_date(2003y/2/1),
+        .expected_string="2003-02-01"
+    },
+    {
+        .case_name="CompleteLeapDay",
+        .raw="2004-02-29",
+        .expected_date=common::partial_date(2004y/2/29),
+        .expected_string="2004-02-29"
+    },
+    {
+        .case_name="CompleteSingleDigitMonthAndDay",
+        .raw="2003-2-1",
+        .expected_date=common::partial_date(2003y/2/1),
+        .expected_string="2003-02-01"
+    },
+    {
+        .case_name="CompleteTrailingTime",
+        .raw="2003-02-01T10:00:00Z",
+        .expected_date=common::partial_date(2003y/2/1),
+        .expected_string="2003-02-01"
+    },
+    {
+        .case_name="CompleteShortYear",
+        .raw="950-02-01",
+        .expected_date=common::partial_date(950y/2/1),
+        .expected_string="0950-02-01"
+    },
+    {
+        .case_name="CompleteNegativeYear",
+        .raw="-44-03-15",
+        .expected_date=common::partial_date(std::chrono::year(-44)/3/15),
+        .expected_string="-0044-03-15"
+    },
+    {
+        .case_name="YearMonth",
+        .raw="1968-11",
+        .expected_date=common::partial_date(1968y, std::chrono::November),
+        .expected_string="1968-11"
+    },
+    {
+        .case_name="Year",
+        .raw="1890",
+        .expected_date=common::partial_date(1890y),
+        .expected_string="1890"
+    },
+    { .case_name="Empty", .raw="", .expected_date={}, .expected_string="" },
+    { .case_name="DayMonthYear", .raw="01-02-2003", .expected_date={}, .expected_string="" },
+    { .case_name="ThreeDigitDay", .raw="2003-02-011", .expected_date={}, .expected_string="" },
+    { .case_name="NonLeapDay", .raw="2003-02-29", .expected_date={}, .expected_string="" },
+    { .case_name="MonthOutOfRange", .raw="2003-13", .expected_date={}, .expected_string="" },
+    { .case_name="ZeroMonth", .raw="2003-00-01", .expected_date={}, .expected_string="" },
+    { .case_name="ZeroDay", .raw="2003-02-00", .expected_date={}, .expected_string="" },
+    { .case_name="FiveDigitYear", .raw="12003-02-01", .expected_date={}, .expected_string="" },
+    { .case_name="MissingDay", .raw="2003-02-", .expected_date={}, .expected_string="" },
+    { .case_name="YearTrailingText", .raw="2003x", .expected_date={}, .expected_string="" },
+    { .case_name="YearMonthTrailingText", .raw="2003-02x", .expected_date={},
+      .expected_string="" },
+    { .case_name="SlashSeparators", .raw="2003/02/01", .expected_date={}, .expected_string="" }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    Date_ParseIsoDate,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+TEST(Date_PartialDate, GetComplete)
+{
+    EXPECT_EQ(common::partial_date(2003y/2/1).get_complete(), 2003y/2/1);
+    EXPECT_EQ(common::partial_date(2003y, std::chrono::February).get_complete(), std::nullopt);
+    EXPECT_FALSE(common::partial_date(2003y).is_complete());
+}
+
+} // namespace test::suite_parse_iso_date
@@ -0,0 +1,71 @@
+#include <string>
+
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/graph_traversal.hpp"
+#include "common/redland_utils.hpp"
+#include "test/tools/redland.hpp"
+
+//  The graph traversal functions tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_graph_traversal
+{
+
+namespace
+{
+
+constexpr const char* k_parent = "http://example.org/parent";
+constexpr const char* k_type = "http://www.w3.org/1999/02/22-rdf-syntax-ns#type";
+constexpr const char* k_person = "http://gedcomx.org/Person";
+
+class GraphTraversal : public ::testing::TestWithParam<common::storage_backend>
+{
+protected:
+    void SetUp() override
+    {
+        common::initialize_redland_ctx(m_ctx, GetParam());
+
+        insert("http://example.org/A", k_parent, "http://example.org/B");
+        insert("http://example.org/A", k_parent, "http://example.org/C");
+        insert("http://example.org/B", k_parent, "http://example.org/C");
+        insert("http://example.org/A", k_type, k_person);
+    }
+
+    void insert(const char* subject, const char* predicate, const char* object)
+    {
+        tools::insert_uuu_statement(m_ctx->world, m_ctx->model, subject, predicate, object);
+    }
+
+    common::scoped_redland_ctx m_ctx { common::create_redland_ctx() };
+};
+
+} // anonymous namespace
+
+TEST_P(GraphTraversal, FindTriples)
+{
+    const common::rdf_triple_buffer all_triples =
+        common::find_triples(m_ctx->world, m_ctx->model, {});
+
+    EXPECT_EQ(all_triples.size(), 4);
+
+    const common::rdf_triple_buffer typed_triples = common::find_triples(
+        m_ctx->world, m_ctx->model,
+        { .subject={}, .predicate=common::make_uri_term(k_type), .object={} });
+
+    ASSERT_EQ(typed_triples.size(), 1);
+    EXPECT_EQ(typed_triples.front().subject.value, "http://example.org/A");
+    EXPECT_EQ(typed_triples.front().object.value, k_person);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    GraphTraversal,
+    ::testing::Values(common::storage_backend::memory, common::storage_backend::native),
+    [](const ::testing::TestParamInfo<common::storage_backend>& info) {
+        return std::string(
+            (info.param == common::storage_backend::native) ? "NativeStorage" : "MemoryStorage");
+    });
+
+} // namespace test::suite_graph_traversal
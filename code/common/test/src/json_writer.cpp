@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "common/json_writer.hpp"
+#include "test/tools/gtest.hpp"
+
+//  The json_writer class tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_json_writer
+{
+
+struct Param
+{
+    const char* case_name;
+    std::function<void(common::json_writer&)> write_fn;
+    nlohmann::json expected_doc;
+};
+
+class JsonWriter_MatchesDump : public ::testing::TestWithParam<Param> {};
+
+// The streamed output is expected to be byte identical to the dump of the equivalent document
+TEST_P(JsonWriter_MatchesDump, NormalSuccessCases)
+{
+    const Param& param = GetParam();
+
+    for (const int indent : { 4, 2, common::json_writer::k_compact })
+    {
+        std::ostringstream os;
+        common::json_writer writer(os, indent);
+        param.write_fn(writer);
+
+        EXPECT_EQ(param.expected_doc.dump(indent), os.str()) << "indent: " << indent;
+        EXPECT_EQ(0, writer.get_depth());
+    }
+}
+
+const std::vector<Param> g_params{
+    {
+        .case_name="Null",
+        .write_fn=[](common::json_writer& w) { w.null_value(); },
+        .expected_doc=nullptr
+    },
+    {
+        .case_name="EmptyContainers",
+        .write_fn=[](common::json_writer& w) {
+            w.begin_object();
+            w.key("array");
+            w.begin_array();
+            w.end_array();
+            w.key("object");
+            w.begin_object();
+            w.end_object();
+            w.end_object();
+        },
+        .expected_doc={
+            { "array", nlohmann::json::array() }, { "object", nlohmann::json::object() } }
+    },
+    {
+        .case_name="Scalars",
+        .write_fn=[](common::json_writer& w) {
+            w.begin_array();
+            w.value("text");
+            w.value(true);
+            w.value(false);
+            w.value(std::int64_t { -1234567890123 });
+            w.null_value();
+            w.end_array();
+        },
+        .expected_doc=nlohmann::json::array({ "text", true, false, -1234567890123, nullptr })
+    },
+    {
+        .case_name="EscapedStrings",
+        .write_fn=[](common::json_writer& w) {
+            w.begin_object();
+            w.key("ctrl");
+            w.value(std::string_view("\x01\x1f\x7f", 3));
+            w.key("quo\"te");
+            w.value("back\\slash\b\f\n\r\t");
+            w.key("utf8");
+            w.value("Zażółć gęślą jaźń");
+            w.end_object();
+        },
+        .expected_doc={
+            { "quo\"te", "back\\slash\b\f\n\r\t" },
+            { "ctrl", "\x01\x1f\x7f" },
+            { "utf8", "Zażółć gęślą jaźń" }
+        }
+    },
+    {
+        .case_name="NestedWithEmbeddedSubtree",
+        .write_fn=[](common::json_writer& w) {
+            w.begin_array();
+            w.begin_object();
+            w.key("items");
+            w.begin_array();
+            w.embed({ { "a", { 1, 2 } }, { "b", nlohmann::json::object() } });
+            w.embed("scalar");
+            w.end_array();
+            w.end_object();
+            w.end_array();
+        },
+        .expected_doc=nlohmann::json::array({
+                { { "items", nlohmann::json::array({
+                                { { "a", { 1, 2 } }, { "b", nlohmann::json::object() } },
+                                "scalar" }) } } })
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    , JsonWriter_MatchesDump, ::testing::ValuesIn(g_params), tools::ParamNameGen<Param>);
+
+} // namespace test::suite_json_writer
@@ -0,0 +1,220 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/file_fingerprint.hpp"
+#include "common/model_cache.hpp"
+#include "test/tools/redland.hpp"
+
+//  The hash_bytes function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_hash_bytes
+{
+
+TEST(FileFingerprint_HashBytes, ReferenceValues)
+{
+    // The FNV-1a reference values
+    EXPECT_EQ(common::hash_bytes(""), 0xcbf29ce484222325ULL);
+    EXPECT_EQ(common::hash_bytes("a"), 0xaf63dc4c8601ec8cULL);
+    EXPECT_EQ(common::hash_bytes("foobar"), 0x85944171f73967e8ULL);
+}
+
+} // namespace test::suite_hash_bytes
+
+//  The write_file_if_changed function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_write_file_if_changed
+{
+
+TEST(FileFingerprint_WriteFileIfChanged, SkipsIdenticalContent)
+{
+    const std::filesystem::path root_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_write_file_if_changed";
+    const std::filesystem::path file_path = root_path / "nested" / "file.json";
+    std::filesystem::remove_all(root_path);
+
+    EXPECT_EQ(common::write_file_if_changed(file_path, "{}\n"), common::write_outcome::written);
+
+    // Make any rewrite observable regardless of the file system timestamp resolution
+    const std::filesystem::file_time_type past_time =
+        std::filesystem::last_write_time(file_path) - std::chrono::hours(1);
+    std::filesystem::last_write_time(file_path, past_time);
+
+    EXPECT_EQ(common::write_file_if_changed(file_path, "{}\n"), common::write_outcome::unchanged);
+    EXPECT_EQ(std::filesystem::last_write_time(file_path), past_time);
+
+    // The same size, different content
+    EXPECT_EQ(common::write_file_if_changed(file_path, "[]\n"), common::write_outcome::written);
+    EXPECT_NE(std::filesystem::last_write_time(file_path), past_time);
+    EXPECT_EQ(common::fingerprint_file(file_path).content_hash, common::hash_bytes("[]\n"));
+
+    EXPECT_EQ(common::write_file_if_changed(file_path, ""), common::write_outcome::written);
+    EXPECT_EQ(std::filesystem::file_size(file_path), 0U);
+    EXPECT_FALSE(std::filesystem::exists(file_path.string() + ".tmp"));
+
+    std::filesystem::remove_all(root_path);
+}
+
+// The content spanning several read chunks is compared byte by byte, up to the last byte
+TEST(FileFingerprint_WriteFileIfChanged, ComparesLargeContent)
+{
+    const std::filesystem::path root_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_write_file_if_changed_large";
+    const std::filesystem::path file_path = root_path / "file.json";
+    std::filesystem::remove_all(root_path);
+
+    std::string content(200 * 1024, 'x');
+
+    EXPECT_EQ(common::write_file_if_changed(file_path, content), common::write_outcome::written);
+    EXPECT_EQ(common::write_file_if_changed(file_path, content), common::write_outcome::unchanged);
+
+    content.back() = 'y';
+    EXPECT_EQ(common::write_file_if_changed(file_path, content), common::write_outcome::written);
+    EXPECT_EQ(common::write_file_if_changed(file_path, content), common::write_outcome::unchanged);
+
+    content[100 * 1024] = 'z';
+    EXPECT_EQ(common::write_file_if_changed(file_path, content), common::write_outcome::written);
+    EXPECT_EQ(common::fingerprint_file(file_path).content_hash, common::hash_bytes(content));
+
+    std::filesystem::remove_all(root_path);
+}
+
+} // namespace test::suite_write_file_if_changed
+
+//  The load_rdf_set_cached function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_load_rdf_set_cached
+{
+
+namespace
+{
+
+void write_turtle_file(const std::filesystem::path& file_path, int person_count)
+{
+    std::ofstream os(file_path, std::ios::trunc);
+    os << "@prefix gx: <http://gedcomx.org/> .\n"
+          "@prefix ex: <http://example.org/> .\n\n";
+
+    for (int idx = 0; idx < person_count; ++idx)
+    {
+        os << fmt::format(
+            "ex:{}P{} a gx:Person ;\n"
+            "    gx:name [ gx:value \"Common Name\" ] .\n",
+            file_path.stem().string(), idx);
+    }
+}
+
+std::size_t load_cached(
+    const common::input_files& input_paths, const std::filesystem::path& cache_path)
+{
+    test::tools::scoped_redland_ctx ctx = test::tools::initialize_redland_ctx();
+    common::load_rdf_set_cached(ctx->world, ctx->model, input_paths, 2, cache_path);
+    return static_cast<std::size_t>(librdf_model_size(ctx->model));
+}
+
+} // anonymous namespace
+
+TEST(ModelCache_LoadRdfSetCached, IncrementalUpdates)
+{
+    const std::filesystem::path dir_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_load_rdf_set_cached";
+    std::filesystem::remove_all(dir_path);
+    std::filesystem::create_directories(dir_path);
+
+    const std::filesystem::path cache_path = dir_path / "model.cache";
+    const std::filesystem::path a_path = dir_path / "a.ttl";
+    const std::filesystem::path b_path = dir_path / "b.ttl";
+    const std::filesystem::path c_path = dir_path / "c.ttl";
+
+    // Every person contributes three statements
+    write_turtle_file(a_path, 1);
+    write_turtle_file(b_path, 2);
+
+    // The initial load creates the cache
+    EXPECT_EQ(load_cached({ a_path, b_path }, cache_path), 9);
+    EXPECT_TRUE(std::filesystem::exists(cache_path));
+
+    common::input_manifest manifest =
+        common::read_input_manifest(common::get_input_manifest_path(cache_path));
+    ASSERT_EQ(manifest.size(), 2);
+    EXPECT_EQ(manifest.at(a_path).triple_count, 3);
+    EXPECT_EQ(manifest.at(b_path).triple_count, 6);
+    EXPECT_EQ(manifest.at(b_path).fingerprint, common::fingerprint_file(b_path));
+
+    // Nothing has changed, the model is restored from the cache
+    EXPECT_EQ(load_cached({ a_path, b_path }, cache_path), 9);
+
+    // A changed, B removed and C added
+    write_turtle_file(a_path, 3);
+    write_turtle_file(c_path, 1);
+
+    EXPECT_EQ(load_cached({ a_path, c_path }, cache_path), 12);
+
+    manifest = common::read_input_manifest(common::get_input_manifest_path(cache_path));
+    ASSERT_EQ(manifest.size(), 2);
+    EXPECT_EQ(manifest.at(a_path).triple_count, 9);
+    EXPECT_EQ(manifest.at(c_path).triple_count, 3);
+    EXPECT_FALSE(manifest.contains(b_path));
+
+    // The blank nodes of the cached and the re-parsed files must not collide
+    EXPECT_EQ(load_cached({ a_path, b_path, c_path }, cache_path), 18);
+
+    std::filesystem::remove_all(dir_path);
+}
+
+// The file failed to parse is left out of the manifest, so the truncated statements aren't reused
+TEST(ModelCache_LoadRdfSetCached, MalformedFileNotCached)
+{
+    const std::filesystem::path dir_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_load_rdf_set_cached_malformed";
+    std::filesystem::remove_all(dir_path);
+    std::filesystem::create_directories(dir_path);
+
+    const std::filesystem::path cache_path = dir_path / "model.cache";
+    const std::filesystem::path a_path = dir_path / "a.ttl";
+    const std::filesystem::path b_path = dir_path / "b.ttl";
+
+    write_turtle_file(a_path, 1);
+    write_turtle_file(b_path, 2);
+    std::ofstream(b_path, std::ios::app) << "ex:bP2 a gx:Person ; gx:name [ gx:value .\n";
+
+    EXPECT_GE(load_cached({ a_path, b_path }, cache_path), 3);
+
+    common::input_manifest manifest =
+        common::read_input_manifest(common::get_input_manifest_path(cache_path));
+    EXPECT_TRUE(manifest.contains(a_path));
+    EXPECT_FALSE(manifest.contains(b_path));
+
+    // The fixed file is parsed again and cached then
+    write_turtle_file(b_path, 2);
+
+    EXPECT_EQ(load_cached({ a_path, b_path }, cache_path), 9);
+
+    manifest = common::read_input_manifest(common::get_input_manifest_path(cache_path));
+    ASSERT_TRUE(manifest.contains(b_path));
+    EXPECT_EQ(manifest.at(b_path).triple_count, 6);
+
+    std::filesystem::remove_all(dir_path);
+}
+
+TEST(ModelCache_ReadInputManifest, MalformedManifest)
+{
+    const std::filesystem::path manifest_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_malformed.manifest.json";
+
+    std::ofstream(manifest_path) << "{ \"version\": 1, \"files\": [ { \"path\": 7 } ] }";
+
+    EXPECT_TRUE(common::read_input_manifest(manifest_path).empty());
+
+    std::filesystem::remove(manifest_path);
+}
+
+} // namespace test::suite_load_rdf_set_cached
@@ -0,0 +1,170 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/common_exception.hpp"
+#include "common/model_snapshot.hpp"
+#include "common/rdf_term.hpp"
+#include "common/redland_utils.hpp"
+#include "test/tools/assertions.hpp"
+#include "test/tools/gtest.hpp"
+#include "test/tools/redland.hpp"
+
+//  The model snapshot round trip tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_model_snapshot
+{
+
+namespace
+{
+
+const std::string k_gx = "http://gedcomx.org/";
+const std::string k_xsd_date = "http://www.w3.org/2001/XMLSchema#date";
+
+common::rdf_term make_term(common::rdf_term::kind type, const std::string& value)
+{
+    common::rdf_term term;
+    term.type = type;
+    term.value = value;
+    return term;
+}
+
+common::rdf_term make_uri(const std::string& value)
+{
+    return make_term(common::rdf_term::kind::uri, value);
+}
+
+common::rdf_term make_blank(const std::string& value)
+{
+    return make_term(common::rdf_term::kind::blank, value);
+}
+
+/** Every person is described with an equally structured set of terms of all the kinds */
+common::rdf_triple_buffer construct_person_triples(int person_idx)
+{
+    const common::rdf_term person = make_uri(fmt::format("http://example.org/P{}", person_idx));
+    const common::rdf_term name = make_blank(fmt::format("f{}_name", person_idx));
+
+    common::rdf_term date =
+        make_term(common::rdf_term::kind::literal, fmt::format("190{}-01-01", person_idx));
+    date.datatype = k_xsd_date;
+
+    common::rdf_term value = make_term(common::rdf_term::kind::literal, "Common Name");
+    value.language = "en";
+
+    return {
+        { person, make_uri(k_gx + "name"), name },
+        { person, make_uri(k_gx + "date"), date },
+        { name, make_uri(k_gx + "value"), value }
+    };
+}
+
+} // anonymous namespace
+
+struct Param
+{
+    const char* case_name;
+    int source_count;
+};
+
+class ModelSnapshot_RoundTrip : public ::testing::TestWithParam<Param> {};
+
+TEST_P(ModelSnapshot_RoundTrip, NormalSuccessCases)
+{
+    const Param& param = GetParam();
+
+    const std::filesystem::path snapshot_path =
+        std::filesystem::temp_directory_path() /
+        fmt::format("gen_common_test_model_snapshot_{}.bin", param.case_name);
+
+    common::model_snapshot_builder builder;
+
+    for (int idx = 0; idx < param.source_count; ++idx)
+    {
+        builder.add_source(fmt::format("source{}.ttl", idx), construct_person_triples(idx));
+    }
+
+    builder.write(snapshot_path);
+
+    const common::scoped_model_snapshot snapshot = common::open_model_snapshot(snapshot_path);
+
+    ASSERT_EQ(
+        common::get_snapshot_source_count(*snapshot), static_cast<std::size_t>(param.source_count));
+    ASSERT_EQ(common::get_snapshot_triple_count(*snapshot), builder.triple_count());
+
+    for (int idx = 0; idx < param.source_count; ++idx)
+    {
+        EXPECT_EQ(
+            common::get_snapshot_source_path(*snapshot, idx),
+            std::filesystem::path(fmt::format("source{}.ttl", idx)));
+
+        test::tools::scoped_redland_ctx source_ctx = test::tools::initialize_redland_ctx();
+        common::load_model_snapshot_source(
+            source_ctx->world, source_ctx->model, *snapshot, idx);
+
+        EXPECT_EQ(librdf_model_size(source_ctx->model), 3);
+    }
+
+    test::tools::scoped_redland_ctx ctx = test::tools::initialize_redland_ctx();
+    common::load_model_snapshot(ctx->world, ctx->model, *snapshot);
+
+    EXPECT_EQ(librdf_model_size(ctx->model), 3 * param.source_count);
+
+    const std::string query = R"(
+        PREFIX gx: <http://gedcomx.org/>
+        PREFIX xsd: <http://www.w3.org/2001/XMLSchema#>
+
+        SELECT ?person
+        WHERE {
+            ?person gx:name ?name ;
+                gx:date ?date .
+            ?name gx:value "Common Name"@en .
+            FILTER(datatype(?date) = xsd:date)
+        })";
+
+    common::exec_query_result res = common::exec_query(ctx->world, ctx->model, query);
+    const auto [head_row, data_table] = common::extract_data_table(res->results);
+
+    EXPECT_EQ(data_table.size(), static_cast<std::size_t>(param.source_count));
+
+    EXPECT_THROW_WITH_CODE(
+        static_cast<void>(common::get_snapshot_source_path(*snapshot, param.source_count)),
+        common::common_exception,
+        common::common_exception::error_code::input_contract_error);
+
+    std::filesystem::remove(snapshot_path);
+}
+
+const std::vector<Param> g_params {
+    { .case_name="NoSources", .source_count=0 },
+    { .case_name="SingleSource", .source_count=1 },
+    { .case_name="MultipleSources", .source_count=4 }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    ModelSnapshot_RoundTrip,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+TEST(ModelSnapshot_Open, InvalidFileFormat)
+{
+    const std::filesystem::path snapshot_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_model_snapshot_invalid.bin";
+
+    std::ofstream(snapshot_path) << "@prefix gx: <http://gedcomx.org/> .\n";
+
+    EXPECT_THROW_WITH_CODE(
+        static_cast<void>(common::open_model_snapshot(snapshot_path)),
+        common::common_exception,
+        common::common_exception::error_code::data_format_error);
+
+    std::filesystem::remove(snapshot_path);
+}
+
+} // namespace test::suite_model_snapshot
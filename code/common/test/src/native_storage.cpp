@@ -0,0 +1,173 @@
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/native_storage.hpp"
+#include "common/redland_utils.hpp"
+#include "test/tools/gtest.hpp"
+#include "test/tools/redland.hpp"
+
+//  The native storage tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_native_storage
+{
+
+namespace
+{
+
+constexpr const char* k_ex = "http://example.org/";
+constexpr const char* k_parent = "http://example.org/parent";
+constexpr const char* k_type = "http://www.w3.org/1999/02/22-rdf-syntax-ns#type";
+constexpr const char* k_person = "http://gedcomx.org/Person";
+constexpr const char* k_name = "http://gedcomx.org/name";
+
+std::string ex(const char* local_name)
+{
+    return fmt::format("{}{}", k_ex, local_name);
+}
+
+common::scoped_redland_ctx create_populated_ctx(common::storage_backend backend)
+{
+    common::scoped_redland_ctx ctx = common::create_redland_ctx();
+    common::initialize_redland_ctx(ctx, backend);
+
+    tools::insert_uuu_statement(ctx->world, ctx->model, ex("A").c_str(), k_parent, ex("B").c_str());
+    tools::insert_uuu_statement(ctx->world, ctx->model, ex("A").c_str(), k_parent, ex("C").c_str());
+    tools::insert_uuu_statement(ctx->world, ctx->model, ex("B").c_str(), k_parent, ex("C").c_str());
+    tools::insert_uuu_statement(ctx->world, ctx->model, ex("A").c_str(), k_type, k_person);
+    tools::insert_uuu_statement(ctx->world, ctx->model, ex("B").c_str(), k_type, k_person);
+    // A duplicate statement must not be stored twice
+    tools::insert_uuu_statement(ctx->world, ctx->model, ex("A").c_str(), k_parent, ex("B").c_str());
+
+    librdf_node* name = librdf_new_node_from_typed_literal(
+        ctx->world, reinterpret_cast<const unsigned char*>("Alice"), "en", nullptr);
+    tools::insert_statement(
+        ctx->world, ctx->model,
+        tools::create_uri_node(ctx->world, ex("A").c_str()),
+        tools::create_uri_node(ctx->world, k_name),
+        name);
+
+    return ctx;
+}
+
+librdf_node* create_optional_uri_node(librdf_world* world, const std::string& uri)
+{
+    return (uri.empty() ? nullptr : tools::create_uri_node(world, uri.c_str()));
+}
+
+int count_statements(librdf_stream* stream)
+{
+    int count = 0;
+
+    for (; !librdf_stream_end(stream); librdf_stream_next(stream))
+    {
+        EXPECT_NE(librdf_stream_get_object(stream), nullptr);
+        ++count;
+    }
+
+    librdf_free_stream(stream);
+
+    return count;
+}
+
+} // anonymous namespace
+
+struct Param
+{
+    const char* case_name;
+    std::string subject;
+    std::string predicate;
+    std::string object;
+    int expected_count;
+};
+
+class NativeStorage_FindStatements : public ::testing::TestWithParam<Param> {};
+
+TEST_P(NativeStorage_FindStatements, NormalSuccessCases)
+{
+    const Param& param = GetParam();
+
+    // The native storage must behave exactly like the reference memory storage
+    for (const auto backend : { common::storage_backend::memory, common::storage_backend::native })
+    {
+        common::scoped_redland_ctx ctx = create_populated_ctx(backend);
+
+        ASSERT_EQ(librdf_model_size(ctx->model), 6);
+
+        // The statement takes the ownership of the nodes
+        librdf_statement* pattern = librdf_new_statement(ctx->world);
+        librdf_statement_set_subject(pattern, create_optional_uri_node(ctx->world, param.subject));
+        librdf_statement_set_predicate(
+            pattern, create_optional_uri_node(ctx->world, param.predicate));
+        librdf_statement_set_object(pattern, create_optional_uri_node(ctx->world, param.object));
+
+        EXPECT_EQ(
+            count_statements(librdf_model_find_statements(ctx->model, pattern)),
+            param.expected_count)
+            << "storage backend: " << static_cast<int>(backend);
+
+        librdf_free_statement(pattern);
+    }
+}
+
+const std::vector<Param> g_params {
+    { .case_name="AnyStatement", .subject="", .predicate="", .object="", .expected_count=6 },
+    { .case_name="BoundSubject", .subject=ex("A"), .predicate="", .object="", .expected_count=4 },
+    { .case_name="BoundPredicate", .subject="", .predicate=k_parent, .object="",
+      .expected_count=3 },
+    { .case_name="BoundObject", .subject="", .predicate="", .object=ex("C"), .expected_count=2 },
+    { .case_name="BoundSubjectPredicate", .subject=ex("A"), .predicate=k_parent, .object="",
+      .expected_count=2 },
+    { .case_name="BoundSubjectObject", .subject=ex("A"), .predicate="", .object=ex("C"),
+      .expected_count=1 },
+    { .case_name="BoundPredicateObject", .subject="", .predicate=k_type, .object=k_person,
+      .expected_count=2 },
+    { .case_name="BoundAll", .subject=ex("B"), .predicate=k_parent, .object=ex("C"),
+      .expected_count=1 },
+    { .case_name="UnknownNode", .subject=ex("Z"), .predicate="", .object="",
+      .expected_count=0 }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    NativeStorage_FindStatements,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+TEST(NativeStorage_Query, RemoveAndQuery)
+{
+    common::scoped_redland_ctx ctx = create_populated_ctx(common::storage_backend::native);
+
+    librdf_statement* statement = librdf_new_statement_from_nodes(
+        ctx->world,
+        tools::create_uri_node(ctx->world, ex("A").c_str()),
+        tools::create_uri_node(ctx->world, k_parent),
+        tools::create_uri_node(ctx->world, ex("B").c_str()));
+
+    EXPECT_NE(librdf_model_contains_statement(ctx->model, statement), 0);
+    EXPECT_EQ(librdf_model_remove_statement(ctx->model, statement), 0);
+    EXPECT_EQ(librdf_model_contains_statement(ctx->model, statement), 0);
+    EXPECT_EQ(librdf_model_size(ctx->model), 5);
+
+    librdf_free_statement(statement);
+
+    const std::string query = R"(
+        PREFIX ex: <http://example.org/>
+        PREFIX gx: <http://gedcomx.org/>
+
+        SELECT ?parent ?name
+        WHERE {
+            ?child ex:parent ?parent .
+            OPTIONAL { ?child gx:name ?name }
+        })";
+
+    common::exec_query_result res = common::exec_query(ctx->world, ctx->model, query);
+    const auto [head_row, data_table] = common::extract_data_table(res->results);
+
+    EXPECT_EQ(data_table.size(), 2);
+}
+
+} // namespace test::suite_native_storage
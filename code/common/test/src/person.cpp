@@ -1,5 +1,12 @@
+#include <chrono>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
 #include <gtest/gtest.h>
 
+#include "common/json_writer.hpp"
 #include "common/person.hpp"
 #include "test/tools/note.hpp"
 
@@ -133,3 +140,84 @@ INSTANTIATE_TEST_SUITE_P(
     tools::ParamNameGen<Param>);
 
 } // namespace test::suite_extract_person_gender
+
+//  The write_person_json function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_write_person_json
+{
+
+namespace
+{
+
+std::shared_ptr<common::Person> make_person(
+    const std::string& id, common::Gender gender, const std::string& given_name,
+    const std::string& last_name)
+{
+    auto person = std::make_shared<common::Person>("http://example.org/" + id);
+    person->gender = gender;
+
+    if (!given_name.empty())
+    {
+        person->given_names.push_back(given_name);
+    }
+
+    if (!last_name.empty())
+    {
+        person->last_names.push_back(last_name);
+    }
+
+    return person;
+}
+
+std::string write_person(const common::Person& person)
+{
+    std::ostringstream os;
+    common::json_writer writer(os);
+    common::write_person_json(writer, person);
+    return os.str();
+}
+
+} // anonymous namespace
+
+TEST(Person_WritePersonJson, MinimalPerson)
+{
+    const common::Person person("http://example.org/P1");
+
+    EXPECT_EQ(common::person_to_json(person).dump(4), write_person(person));
+}
+
+// The streamed person is expected to match the person_to_json output byte for byte
+TEST(Person_WritePersonJson, PersonWithRelatives)
+{
+    auto proband = make_person("P1", common::Gender::Male, "John \"Jack\"", "Smith");
+    proband->birth_date = common::partial_date(std::chrono::year(1901));
+    proband->death_date = common::partial_date(
+        std::chrono::year(1970), std::chrono::month(2));
+    proband->father = make_person("P2", common::Gender::Male, "Adam", "Smith");
+    proband->father->birth_date = std::chrono::year(1870) / 3 / 14;
+    proband->mother = make_person("P3", common::Gender::Female, "Eve", "");
+    proband->notes().emplace_back(
+        common::Note::Type::Warning, "SOME_NOTE",
+        std::set<common::Variable>{ { .name = "count", .value = 2 } }, "Some diagnostic text");
+
+    const auto wife = make_person("P4", common::Gender::Female, "Mary", "Brown");
+    const auto partner = make_person("P5", common::Gender::Unknown, "", "");
+    const auto child = make_person("P6", common::Gender::Female, "Ann", "Smith");
+    const auto partner_child = make_person("P7", common::Gender::Male, "", "Smith");
+    const auto single_parent_child = make_person("P8", common::Gender::Male, "Bob", "Smith");
+
+    // The partner's own single parent children are replaced by the children with the proband
+    wife->children[common::Resource()].push_back(make_person("P9", common::Gender::Male, "", ""));
+    partner->children[common::Resource()].push_back(single_parent_child);
+
+    proband->partners.push_back({ .partner = wife, .is_inferred = false });
+    proband->partners.push_back({ .partner = partner, .is_inferred = true });
+    proband->children[*wife].push_back(child);
+    proband->children[*wife].push_back(partner_child);
+    proband->children[common::Resource()].push_back(single_parent_child);
+
+    EXPECT_EQ(common::person_to_json(*proband).dump(4), write_person(*proband));
+}
+
+} // namespace test::suite_write_person_json
@@ -0,0 +1,230 @@
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/common_exception.hpp"
+#include "common/query_template.hpp"
+#include "common/redland_utils.hpp"
+#include "test/tools/assertions.hpp"
+#include "test/tools/gtest.hpp"
+#include "test/tools/redland.hpp"
+
+//  The query_template::bind function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_query_template_bind
+{
+
+struct Param
+{
+    const char* case_name;
+    std::string template_text;
+    common::query_bindings bindings;
+    std::string expected_query;
+};
+
+class QueryTemplate_Bind : public ::testing::TestWithParam<Param> {};
+
+TEST_P(QueryTemplate_Bind, NormalSuccessCases)
+{
+    const Param& param = GetParam();
+
+    const common::query_template query("test", param.template_text);
+
+    EXPECT_EQ(query.bind(param.bindings), param.expected_query);
+}
+
+const std::vector<Param> g_params {
+    {
+        .case_name="NoParameters",
+        .template_text="SELECT ?s WHERE { ?s ?p ?o }",
+        .bindings={},
+        .expected_query="SELECT ?s WHERE { ?s ?p ?o }"
+    },
+    {
+        .case_name="SingleParameter",
+        .template_text="SELECT ?p WHERE { %{s} ?p ?o }",
+        .bindings={ { "s", "http://example.org/P1" } },
+        .expected_query="SELECT ?p WHERE { <http://example.org/P1> ?p ?o }"
+    },
+    {
+        .case_name="RepeatedParameters",
+        .template_text="ASK { %{s} ?p %{o} . %{o} ?p %{s} }",
+        .bindings={ { "s", "http://example.org/P1" }, { "o", "http://example.org/P2" } },
+        .expected_query=(
+            "ASK { <http://example.org/P1> ?p <http://example.org/P2> ."
+            " <http://example.org/P2> ?p <http://example.org/P1> }")
+    },
+    {
+        .case_name="UnusedBinding",
+        .template_text="%{s}",
+        .bindings={ { "s", "urn:a" }, { "o", "urn:b" } },
+        .expected_query="<urn:a>"
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    QueryTemplate_Bind,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+TEST(QueryTemplate_BindErrors, InvalidBindings)
+{
+    const common::query_template query("test", "SELECT ?p WHERE { %{s} ?p ?o }");
+
+    EXPECT_THROW_WITH_CODE(
+        static_cast<void>(query.bind({})),
+        common::common_exception,
+        common::common_exception::error_code::input_contract_error);
+
+    // An attempt to close the IRI reference and inject a query fragment
+    EXPECT_THROW_WITH_CODE(
+        static_cast<void>(query.bind({ { "s", "urn:a> ?x ?y . <urn:b" } })),
+        common::common_exception,
+        common::common_exception::error_code::input_contract_error);
+
+    EXPECT_THROW_WITH_CODE(
+        static_cast<void>(query.bind({ { "s", "" } })),
+        common::common_exception,
+        common::common_exception::error_code::input_contract_error);
+}
+
+TEST(QueryTemplate_Construct, InvalidTemplates)
+{
+    EXPECT_THROW_WITH_CODE(
+        common::query_template("test", "SELECT ?p WHERE { %{s ?p ?o"),
+        common::common_exception,
+        common::common_exception::error_code::input_contract_error);
+
+    EXPECT_THROW_WITH_CODE(
+        common::query_template("test", "SELECT ?p WHERE { %{} ?p ?o }"),
+        common::common_exception,
+        common::common_exception::error_code::input_contract_error);
+}
+
+} // namespace test::suite_query_template_bind
+
+//  The exec_templated_query function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_exec_templated_query
+{
+
+// The repeated executions are expected to reflect the model modifications, including the ones
+//  that don't change the model size
+TEST(QueryTemplate_Exec, ModifiedModel)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+
+    const common::query_template query("test", "SELECT ?o WHERE { %{s} <urn:parent> ?o }");
+
+    const common::extract_data_table_result first =
+        common::exec_templated_query(ctx->world, ctx->model, query, { { "s", "urn:P1" } });
+
+    ASSERT_EQ(std::get<1>(first).size(), 1);
+    EXPECT_EQ(std::get<1>(first)[0].at("o"), "urn:P2");
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P3");
+
+    const common::extract_data_table_result second =
+        common::exec_templated_query(ctx->world, ctx->model, query, { { "s", "urn:P1" } });
+
+    EXPECT_EQ(std::get<1>(second).size(), 2);
+
+    tools::remove_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P4");
+
+    const common::extract_data_table_result third =
+        common::exec_templated_query(ctx->world, ctx->model, query, { { "s", "urn:P1" } });
+
+    EXPECT_NE(std::get<1>(third), std::get<1>(second));
+    EXPECT_EQ(std::get<1>(third).size(), 2);
+}
+
+} // namespace test::suite_exec_templated_query
+
+//  The visit_templated_query function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_visit_templated_query
+{
+
+TEST(QueryTemplate_Visit, StreamedRows)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P3");
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P2", "urn:spouse", "urn:P4");
+
+    const common::query_template query("test", R"(
+        SELECT ?o ?spouse
+        WHERE {
+            %{s} <urn:parent> ?o .
+            OPTIONAL { ?o <urn:spouse> ?spouse }
+        }
+        ORDER BY ?o)");
+
+    std::vector<std::pair<std::string, std::optional<std::string>>> rows;
+
+    const std::size_t count = common::visit_templated_query(
+        ctx->world, ctx->model, query, { { "s", "urn:P1" } },
+        [&rows](const common::query_row_view& row) {
+            const std::optional<std::string_view> spouse = row.find("spouse");
+
+            rows.emplace_back(
+                std::string(row.get_req("o")),
+                spouse ? std::optional<std::string>(*spouse) : std::nullopt);
+
+            EXPECT_FALSE(row.find("unknown").has_value());
+            EXPECT_THROW(
+                { std::ignore = row.get_req("unknown"); },
+                common::common_exception);
+        });
+
+    EXPECT_EQ(count, 2);
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[0].first, "urn:P2");
+    EXPECT_EQ(rows[0].second, "urn:P4");
+    EXPECT_EQ(rows[1].first, "urn:P3");
+    EXPECT_EQ(rows[1].second, std::nullopt);
+}
+
+TEST(QueryTemplate_Visit, VisitorException)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+
+    const common::query_template query("test", "SELECT ?o WHERE { %{s} <urn:parent> ?o }");
+
+    EXPECT_THROW(
+        {
+            common::visit_templated_query(
+                ctx->world, ctx->model, query, { { "s", "urn:P1" } },
+                [](const common::query_row_view&) {
+                    throw std::runtime_error("visitor failure");
+                });
+        },
+        std::runtime_error);
+}
+
+} // namespace test::suite_visit_templated_query
@@ -1,12 +1,17 @@
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <utility>
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 #include <redland.h>
 
 #include "common/common_exception.hpp"
+#include "common/redland_utils.hpp"
 #include "common/resource.hpp"
 #include "test/tools/assertions.hpp"
+#include "test/tools/gtest.hpp"
 #include "test/tools/redland.hpp"
 
 //  The exec_query function tests
@@ -139,3 +144,102 @@ TEST(RedlandUtils_ExtractBooleanResult, ResultsTypeFailure)
         common::extract_boolean_result(negative_res->results),
         common::common_exception, common::common_exception::error_code::input_contract_error);
 }
+
+//  The load_rdf_set function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_load_rdf_set
+{
+
+namespace
+{
+
+/** Every file describes a single person with an identically structured blank node name. The blank
+ *   node identifiers generated by separate parser instances could collide, which would merge the
+ *   `_:name gx:value "Common Name"` statements of different files into a single statement. */
+constexpr int k_file_count = 5;
+constexpr int k_statements_per_file = 4;
+
+std::string construct_turtle_file_content(int file_idx)
+{
+    return fmt::format(
+        "@prefix gx: <http://gedcomx.org/> .\n"
+        "@prefix ex: <http://example.org/> .\n"
+        "\n"
+        "ex:P{0} a gx:Person ;\n"
+        "    gx:name [\n"
+        "        gx:type gx:BirthName ;\n"
+        "        gx:value \"Common Name\" ] .\n", file_idx);
+}
+
+common::input_files write_turtle_files(const std::filesystem::path& dir_path)
+{
+    std::filesystem::create_directories(dir_path);
+
+    common::input_files result;
+
+    for (int file_idx = 0; file_idx < k_file_count; ++file_idx)
+    {
+        const std::filesystem::path file_path = dir_path / fmt::format("file{}.ttl", file_idx);
+        std::ofstream(file_path) << construct_turtle_file_content(file_idx);
+        result.insert(file_path);
+    }
+
+    return result;
+}
+
+} // anonymous namespace
+
+struct Param
+{
+    const char* case_name;
+    unsigned int thread_count;
+};
+
+class RedlandUtils_LoadRdfSet : public ::testing::TestWithParam<Param> {};
+
+TEST_P(RedlandUtils_LoadRdfSet, NormalSuccessCases)
+{
+    const Param& param = GetParam();
+
+    const std::filesystem::path dir_path =
+        std::filesystem::temp_directory_path() /
+        fmt::format("gen_common_test_load_rdf_set_{}", param.case_name);
+    const common::input_files input_paths = write_turtle_files(dir_path);
+
+    test::tools::scoped_redland_ctx ctx = test::tools::initialize_redland_ctx();
+    common::load_rdf_set(ctx->world, ctx->model, input_paths, param.thread_count);
+
+    std::filesystem::remove_all(dir_path);
+
+    EXPECT_EQ(librdf_model_size(ctx->model), k_file_count * k_statements_per_file);
+
+    const std::string query = R"(
+        PREFIX gx: <http://gedcomx.org/>
+
+        SELECT DISTINCT ?name
+        WHERE {
+            ?person a gx:Person ;
+                gx:name ?name .
+        })";
+
+    common::exec_query_result res = common::exec_query(ctx->world, ctx->model, query);
+    const auto [head_row, data_table] = common::extract_data_table(res->results);
+
+    EXPECT_EQ(data_table.size(), static_cast<std::size_t>(k_file_count));
+}
+
+const std::vector<Param> g_params {
+    { .case_name="Sequential", .thread_count=1 },
+    { .case_name="TwoThreads", .thread_count=2 },
+    { .case_name="MoreThreadsThanFiles", .thread_count=16 },
+    { .case_name="HardwareThreads", .thread_count=0 }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    RedlandUtils_LoadRdfSet,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+} // namespace test::suite_load_rdf_set
@@ -0,0 +1,132 @@
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common/model_snapshot.hpp"
+#include "common/rdf_term.hpp"
+#include "common/source_index.hpp"
+
+//  The source_index class tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_source_index
+{
+
+namespace
+{
+
+common::rdf_term make_term(common::rdf_term::kind type, const std::string& value)
+{
+    common::rdf_term term;
+    term.type = type;
+    term.value = value;
+    return term;
+}
+
+common::rdf_term make_uri(const std::string& value)
+{
+    return make_term(common::rdf_term::kind::uri, value);
+}
+
+const common::rdf_term g_p1 = make_uri("http://example.org/P1");
+const common::rdf_term g_p2 = make_uri("http://example.org/P2");
+const common::rdf_term g_p3 = make_uri("http://example.org/P3");
+const common::rdf_term g_parent = make_uri("http://example.org/parent");
+const common::rdf_term g_name = make_uri("http://example.org/name");
+const common::rdf_term g_blank = make_term(common::rdf_term::kind::blank, "b1");
+const common::rdf_term g_literal = make_term(common::rdf_term::kind::literal, "Name");
+
+/* P1 is described by both files, P2 only by the first one and P3 is only referenced (as an
+ * object), so it's not described by any file */
+const common::rdf_triple_buffer g_file1_triples {
+    { g_p1, g_name, g_literal },
+    { g_p1, g_parent, g_p3 },
+    { g_p2, g_name, g_literal },
+    { g_p1, g_name, g_blank }
+};
+
+const common::rdf_triple_buffer g_file2_triples {
+    { g_p1, g_parent, g_p2 },
+    { g_blank, g_name, g_literal }
+};
+
+void expect_sources(const common::source_index& index)
+{
+    EXPECT_EQ(
+        (common::file_set{ "data/1.ttl", "data/2.ttl" }),
+        index.get_sources("http://example.org/P1"));
+    EXPECT_EQ(common::file_set{ "data/1.ttl" }, index.get_sources("http://example.org/P2"));
+    EXPECT_TRUE(index.get_sources("http://example.org/P3").empty());
+    EXPECT_TRUE(index.get_sources("b1").empty());
+    EXPECT_EQ(2U, index.get_source_count());
+    EXPECT_EQ(2U, index.get_resource_count());
+}
+
+} // anonymous namespace
+
+TEST(SourceIndex_AddSource, DescribedResources)
+{
+    common::source_index index;
+    index.add_source("data/1.ttl", g_file1_triples);
+    index.add_source("data/2.ttl", g_file2_triples);
+
+    expect_sources(index);
+}
+
+TEST(SourceIndex_Intersect, DescribedResources)
+{
+    common::source_index index;
+    index.add_source("data/1.ttl", g_file1_triples);
+    index.add_source("data/2.ttl", g_file2_triples);
+
+    const std::map<std::string, common::file_set, std::less<>> expected {
+        { "http://example.org/P1", { "data/1.ttl", "data/2.ttl" } },
+        { "http://example.org/P2", { "data/1.ttl" } }
+    };
+
+    // The unsorted input with a duplicate, an undescribed and an unknown resource
+    EXPECT_EQ(
+        expected,
+        index.intersect({
+                "http://example.org/P2", "http://example.org/P3", "http://example.org/P1",
+                "http://example.org/P0", "http://example.org/P2" }));
+    EXPECT_TRUE(index.intersect({}).empty());
+}
+
+TEST(SourceIndex_AddSource, SubjectUris)
+{
+    const std::vector<std::string> file1_subjects {
+        "http://example.org/P1", "http://example.org/P2", "http://example.org/P1" };
+    const std::vector<std::string> file2_subjects { "http://example.org/P1" };
+
+    common::source_index index;
+    index.add_source("data/1.ttl", file1_subjects);
+    index.add_source("data/2.ttl", file2_subjects);
+
+    expect_sources(index);
+}
+
+// The snapshot preserves the statement provenance, so the index built from it is the same
+TEST(SourceIndex_BuildSourceIndex, SnapshotRoundTrip)
+{
+    const std::filesystem::path snapshot_path =
+        std::filesystem::temp_directory_path() / "gen_common_test_source_index.snapshot";
+
+    common::model_snapshot_builder builder;
+    builder.add_source("data/1.ttl", g_file1_triples);
+    builder.add_source("data/2.ttl", g_file2_triples);
+    builder.write(snapshot_path);
+
+    {
+        const common::scoped_model_snapshot snapshot = common::open_model_snapshot(snapshot_path);
+        expect_sources(common::build_source_index(*snapshot));
+    }
+
+    std::filesystem::remove(snapshot_path);
+}
+
+} // namespace test::suite_source_index
@@ -142,4 +142,26 @@ void insert_uuu_statement(
     insert_statement(world, model, subject_node, predicate_node, object_node);
 }
 
+void remove_uuu_statement(
+    librdf_world* world, librdf_model* model,
+    const char* subject, const char* predicate, const char* object)
+{
+    librdf_statement* statement = librdf_new_statement_from_nodes(
+        world, create_uri_node(world, subject), create_uri_node(world, predicate),
+        create_uri_node(world, object));
+
+    if (!statement)
+    {
+        throw tc_error("Test Arrange: Failed to create a redland statement");
+    }
+
+    const int error = librdf_model_remove_statement(model, statement);
+    librdf_free_statement(statement);
+
+    if (error)
+    {
+        throw tc_error("Test Arrange: Failed to remove the statement");
+    }
+}
+
 } // namespace test::tools
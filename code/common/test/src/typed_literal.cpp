@@ -0,0 +1,278 @@
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <redland.h>
+
+#include "common/column_table.hpp"
+#include "common/common_exception.hpp"
+#include "common/date.hpp"
+#include "common/person.hpp"
+#include "common/query_template.hpp"
+#include "common/typed_literal.hpp"
+#include "test/tools/gtest.hpp"
+#include "test/tools/redland.hpp"
+
+using namespace std::chrono_literals;
+
+
+//  The xsd:date literal conversion tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_convert_date_literal
+{
+
+struct Param
+{
+    const char* case_name;
+    std::string lexical;
+    std::optional<common::partial_date> expected_date;
+};
+
+class TypedLiteral_ConvertDateLiteral : public ::testing::TestWithParam<Param> {};
+
+// The xsd:date literals are expected to follow the parse_iso_date (and convert_date) semantics
+TEST_P(TypedLiteral_ConvertDateLiteral, Cases)
+{
+    const Param& param = GetParam();
+
+    EXPECT_EQ(common::parse_iso_date(param.lexical), param.expected_date);
+
+    if (param.expected_date)
+    {
+        EXPECT_EQ(
+            common::convert_literal(param.lexical, common::k_xsd_date),
+            common::typed_cell(*param.expected_date));
+    }
+    else
+    {
+        EXPECT_THROW(
+            { std::ignore = common::convert_literal(param.lexical, common::k_xsd_date); },
+            common::common_exception);
+    }
+}
+
+const std::vector<Param> g_params{
+    { .case_name="Regular", .lexical="2003-02-01",
+      .expected_date=common::partial_date(2003y/2/1) },
+    { .case_name="SingleDigitMonthAndDay", .lexical="1970-5-12",
+      .expected_date=common::partial_date(1970y/5/12) },
+    { .case_name="UtcTimezone", .lexical="2003-02-01Z",
+      .expected_date=common::partial_date(2003y/2/1) },
+    { .case_name="OffsetTimezone", .lexical="2003-02-01+02:00",
+      .expected_date=common::partial_date(2003y/2/1) },
+    { .case_name="Year", .lexical="1890", .expected_date=common::partial_date(1890y) },
+    { .case_name="Empty", .lexical="", .expected_date={} },
+    { .case_name="NonLeapDay", .lexical="2003-02-29", .expected_date={} },
+    { .case_name="FiveDigitYear", .lexical="12003-02-01", .expected_date={} },
+    { .case_name="DayMonthYear", .lexical="01-02-2003", .expected_date={} }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    TypedLiteral_ConvertDateLiteral,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+} // namespace test::suite_convert_date_literal
+
+//  The convert_literal function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_convert_literal
+{
+
+TEST(TypedLiteral_ConvertLiteral, DefaultConverters)
+{
+    EXPECT_EQ(common::convert_literal("true", common::k_xsd_boolean), common::typed_cell(true));
+    EXPECT_EQ(common::convert_literal("0", common::k_xsd_boolean), common::typed_cell(false));
+    EXPECT_EQ(
+        common::convert_literal("-42", common::k_xsd_integer),
+        common::typed_cell(std::int64_t(-42)));
+    EXPECT_EQ(
+        common::convert_literal("+7", common::k_xsd_long), common::typed_cell(std::int64_t(7)));
+    EXPECT_EQ(
+        common::convert_literal("2003-02-01", common::k_xsd_date),
+        common::typed_cell(common::partial_date(2003y/2/1)));
+
+    // No datatype and an unknown datatype
+    EXPECT_EQ(
+        common::convert_literal("true", ""), common::typed_cell(std::string_view("true")));
+    EXPECT_EQ(
+        common::convert_literal("1.5", "http://www.w3.org/2001/XMLSchema#decimal"),
+        common::typed_cell(std::string_view("1.5")));
+
+    EXPECT_THROW(
+        { std::ignore = common::convert_literal("yes", common::k_xsd_boolean); },
+        common::common_exception);
+    EXPECT_THROW(
+        { std::ignore = common::convert_literal("12a", common::k_xsd_integer); },
+        common::common_exception);
+    EXPECT_THROW(
+        { std::ignore = common::convert_literal("99999999999999999999", common::k_xsd_int); },
+        common::common_exception);
+}
+
+TEST(TypedLiteral_ConvertLiteral, CustomConverter)
+{
+    common::literal_converter_lut lut = common::get_default_literal_converters();
+    lut.emplace(
+        "urn:flag",
+        [](std::string_view lexical) { return common::typed_cell(lexical == "yes"); });
+
+    EXPECT_EQ(common::convert_literal("yes", "urn:flag", lut), common::typed_cell(true));
+    EXPECT_EQ(
+        common::convert_literal("yes", "urn:flag"), common::typed_cell(std::string_view("yes")));
+}
+
+TEST(TypedLiteral_ConvertLiteral, CellInterpretation)
+{
+    EXPECT_TRUE(common::get_boolean(common::typed_cell(true)));
+    EXPECT_TRUE(common::get_boolean(common::typed_cell(std::int64_t(2))));
+    EXPECT_FALSE(common::get_boolean(common::typed_cell(std::string_view("false"))));
+    EXPECT_EQ(
+        common::get_date(common::typed_cell(std::string_view("2003-02"))),
+        common::partial_date(2003y, std::chrono::February));
+
+    EXPECT_THROW(
+        { std::ignore = common::get_boolean(common::typed_cell(common::partial_date(2003y))); },
+        common::common_exception);
+    EXPECT_THROW(
+        { std::ignore = common::get_date(common::typed_cell(true)); },
+        common::common_exception);
+}
+
+} // namespace test::suite_convert_literal
+
+//  The typed query result cells tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_typed_query_cells
+{
+
+const char* g_query = R"(
+    PREFIX xsd: <http://www.w3.org/2001/XMLSchema#>
+
+    SELECT ?o ?date ?flag ?count ?plain
+    WHERE {
+        %{s} <urn:parent> ?o .
+        BIND("2003-02-01"^^xsd:date AS ?date)
+        BIND(true AS ?flag)
+        BIND(7 AS ?count)
+        BIND("2003-02-01" AS ?plain)
+    })";
+
+TEST(TypedLiteral_QueryCells, StreamedRow)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+
+    const common::query_template query("test", g_query);
+
+    const std::size_t count = common::visit_templated_query(
+        ctx->world, ctx->model, query, { { "s", "urn:P1" } },
+        [](const common::query_row_view& row) {
+            EXPECT_EQ(
+                common::find_typed_value(row, "date"),
+                common::typed_cell(common::partial_date(2003y/2/1)));
+            EXPECT_EQ(common::find_typed_value(row, "flag"), common::typed_cell(true));
+            EXPECT_EQ(
+                common::find_typed_value(row, "count"), common::typed_cell(std::int64_t(7)));
+            EXPECT_EQ(
+                common::find_typed_value(row, "plain"),
+                common::typed_cell(std::string_view("2003-02-01")));
+            EXPECT_EQ(
+                common::find_typed_value(row, "o"),
+                common::typed_cell(std::string_view("urn:P2")));
+            EXPECT_EQ(common::find_typed_value(row, "unknown"), std::nullopt);
+        });
+
+    EXPECT_EQ(count, 1);
+}
+
+TEST(TypedLiteral_QueryCells, ColumnTable)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P2");
+    tools::insert_uuu_statement(
+        ctx->world, ctx->model, "urn:P1", "urn:parent", "urn:P3");
+
+    const common::query_template query("test", g_query);
+    const common::column_table table = common::exec_templated_column_query(
+        ctx->world, ctx->model, query, { { "s", "urn:P1" } });
+
+    ASSERT_EQ(table.get_row_count(), 2);
+
+    const auto date_col = table.get_column_req("date");
+    const auto flag_col = table.get_column_req("flag");
+
+    for (std::size_t row = 0; row < table.get_row_count(); ++row)
+    {
+        EXPECT_EQ(table.get_datatype(row, date_col), common::k_xsd_date);
+        EXPECT_EQ(
+            table.get_typed(row, date_col), common::typed_cell(common::partial_date(2003y/2/1)));
+        EXPECT_EQ(table.get_typed(row, flag_col), common::typed_cell(true));
+    }
+}
+
+// The birth date extracted from the streamed row (the list command) is expected to be the same as
+//  the one extracted from the data_row (the details command)
+TEST(TypedLiteral_QueryCells, DatePathsAgree)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    for (const char* lexical : { "1970-5-12", "1970-05-12", "1970-05", "1970" })
+    {
+        librdf_uri* xsd_date = librdf_new_uri(
+            ctx->world, reinterpret_cast<const unsigned char*>(common::k_xsd_date.data()));
+        tools::insert_statement(
+            ctx->world, ctx->model,
+            tools::create_uri_node(ctx->world, fmt::format("urn:{}", lexical).c_str()),
+            tools::create_uri_node(ctx->world, "urn:birthDate"),
+            librdf_new_node_from_typed_literal(
+                ctx->world, reinterpret_cast<const unsigned char*>(lexical), nullptr, xsd_date));
+        librdf_free_uri(xsd_date);
+    }
+
+    const common::query_template query("test", R"(
+        SELECT ?date
+        WHERE {
+            %{s} <urn:birthDate> ?date .
+        })");
+
+    for (const char* lexical : { "1970-5-12", "1970-05-12", "1970-05", "1970" })
+    {
+        const std::string subject = fmt::format("urn:{}", lexical);
+
+        common::Person streamed_person(subject);
+        const std::size_t count = common::visit_templated_query(
+            ctx->world, ctx->model, query, { { "s", subject } },
+            [&streamed_person](const common::query_row_view& row) {
+                common::extract_person_birth_date(streamed_person, row, "date");
+            });
+
+        common::Person row_person(subject);
+        const auto [head, rows] =
+            common::exec_templated_query(ctx->world, ctx->model, query, { { "s", subject } });
+
+        ASSERT_EQ(count, 1) << lexical;
+        ASSERT_EQ(rows.size(), 1) << lexical;
+
+        common::extract_person_birth_date(row_person, rows.front(), "date");
+
+        EXPECT_EQ(streamed_person.birth_date, common::parse_iso_date(lexical)) << lexical;
+        EXPECT_EQ(streamed_person.birth_date, row_person.birth_date) << lexical;
+    }
+}
+
+} // namespace test::suite_typed_query_cells
@@ -1,19 +1,63 @@
 #if !defined PERSON_COMMAND_COMMON_HPP
 #define PERSON_COMMAND_COMMON_HPP
 
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
 #include "common/file_system_utils.hpp"
 #include "common/redland_utils.hpp"
 #include "common/resource.hpp"
+#include "common/source_index.hpp"
 
 #include "person/option_parser.hpp"
 
 namespace person
 {
 
-common::scoped_redland_ctx load_input_data(const cli_options& options);
+/** @brief Load the input data into a new redland context
+ *
+ *  The data is loaded from the model snapshot when the --snapshot option is specified, from the
+ *   turtle input files through the model cache when the --cache option is specified and directly
+ *   from the turtle input files otherwise.
+ *
+ *  @param sources the optional index receiving the provenance of the loaded statements (see
+ *      common::source_index), recorded during the very same load */
+common::scoped_redland_ctx load_input_data(
+    const cli_options& options, common::source_index* sources = nullptr);
 
 common::input_files determine_input_paths(const cli_options& options);
 
+/** @brief Get the path of the model snapshot reflecting the input data
+ *
+ *  The model cache is a model snapshot too. It is up to date once the load_input_data function
+ *   returns. */
+std::optional<std::filesystem::path> get_model_snapshot_path(const cli_options& options);
+
+/** @brief Get the nlohmann::json::dump (and json_writer) indent of the output format
+ *
+ *  A single document is written the same way in the compact and the ndjson formats. */
+int get_json_indent(output_format format);
+
+/** @brief Check if the output format is one of the binary (cbor, msgpack) encodings */
+bool is_binary_format(output_format format);
+
+/** @brief Get the extension of the files of the output format (json, cbor or msgpack) */
+std::string get_output_extension(output_format format);
+
+/** @brief Encode the single document in the output format
+ *
+ *  The textual documents are terminated with the line break. */
+std::string encode_document(const nlohmann::json& document, output_format format);
+
+/** @brief Escape the path for the ninja build and dyndep files
+ *
+ *  The space, the colon and the dollar sign characters are prefixed with the dollar sign. */
+std::string escape_ninja_path(std::string_view path);
+
 }
 
 #endif // !defined PERSON_COMMAND_COMMON_HPP
@@ -1,13 +1,78 @@
 #if !defined PERSON_COMMAND_DETAILS_HPP
 #define PERSON_COMMAND_DETAILS_HPP
 
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <redland.h>
+
 #include "person/option_parser.hpp"
+#include "person/queries/details.hpp"
+#include "person/queries/identity_map.hpp"
 
 namespace person
 {
 
 void run_details_command(const cli_options& options);
 
+namespace detail
+{
+
+/** @brief Retrieve the details document of the person (as printed by the details command)
+ *
+ *  @throws person_exception (resource_not_found) when the person resource doesn't exist
+ *  @throws common::common_exception (redland_query_error) on the query execution error */
+nlohmann::json retrieve_person_details(
+    const std::string& person_uri, librdf_world* world, librdf_model* model,
+    const relatives_query_options& options, person_identity_map& persons);
+
+/** @brief Read the person uris listed in the file
+ *
+ *  The file lists one uri per line. The surrounding whitespace, the empty lines and the lines
+ *   starting with the '#' character are ignored.
+ *
+ *  @throws common::common_exception (general_runtime_error) when the file can't be read */
+std::vector<std::string> read_person_uri_list(const std::filesystem::path& list_path);
+
+struct details_write_stats
+{
+    std::size_t written_count { 0 };
+    /** The number of the files skipped because they already had the generated content */
+    std::size_t unchanged_count { 0 };
+};
+
+/** @brief Write the details documents of the persons into the <unique_id>.<extension> files
+ *
+ *  The model is loaded once and the documents are generated by a pool of worker threads, each
+ *   keeping its own identity map across the persons it processes. The calling thread queries the
+ *   loaded model, every other worker queries its own copy of the model, which it fills at its
+ *   start. The statement buffer the copies are filled from is released once all the copies are
+ *   filled, so N workers hold about N times the memory of the loaded model.
+ *
+ *  The files have the same content as the output of the single person details command. The files
+ *   that already have the generated content are not rewritten (see common::write_file_if_changed),
+ *   so their last write time is preserved.
+ *
+ *  @param thread_count the number of the worker threads (0 selects the number of hardware
+ *      threads)
+ *  @param query_thread_count the number of the threads running the relative lookups of a person
+ *      (see relatives_lookup_pool). Each worker holds the query_thread_count - 1 additional copies
+ *      of the model, filled along with the worker copy.
+ *  @param format the encoding of the files (the compact and the ndjson formats are equivalent
+ *      here), which also determines the file extension (see get_output_extension)
+ *
+ *  @throws the first failure of the workers (the remaining persons are skipped then) */
+details_write_stats write_person_details(
+    const std::vector<std::string>& person_uris, librdf_world* world, librdf_model* model,
+    const std::filesystem::path& tgt_root_path, query_backend backend,
+    common::storage_backend storage_backend, unsigned int thread_count,
+    unsigned int query_thread_count, output_format format = output_format::pretty);
+
+} // namespace detail
+
 } // namespace person
 
 #endif // !defined PERSON_COMMAND_DETAILS_HPP
@@ -0,0 +1,16 @@
+#if !defined PERSON_COMMAND_SNAPSHOT_HPP
+#define PERSON_COMMAND_SNAPSHOT_HPP
+
+#include "person/option_parser.hpp"
+
+namespace person
+{
+
+/** @brief Parse the input turtle files and save them as a binary model snapshot
+ *
+ *  @throws person_exception (input_contract_error) when the input is specified as a snapshot */
+void run_snapshot_command(const cli_options& options);
+
+} // namespace person
+
+#endif // !defined PERSON_COMMAND_SNAPSHOT_HPP
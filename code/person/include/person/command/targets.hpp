@@ -1,6 +1,14 @@
 #if !defined PERSON_COMMAND_TARGETS_HPP
 #define PERSON_COMMAND_TARGETS_HPP
 
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "common/file_system_utils.hpp"
+#include "common/resource.hpp"
 #include "person/option_parser.hpp"
 
 namespace person
@@ -8,6 +16,34 @@ namespace person
 
 void run_targets_command(const cli_options& options);
 
+namespace detail
+{
+
+/** @brief The ninja dyndep file the build statements of the targets are bound to */
+struct ninja_dyndep_edge
+{
+    std::filesystem::path path;
+    /** The NAME of the rule producing the dyndep file (e.g. running the deps command) */
+    std::string rule_name;
+    /** The input data files of the dyndep file */
+    common::file_set input_paths;
+};
+
+/** @brief Print the build.ninja fragment of the person targets
+ *
+ *  Every target gets a build statement of the @p rule_name rule with the person uri bound to the
+ *   person_uri variable. When the @p dyndep is specified, the statements are bound to the dyndep
+ *   file listing the data files each target depends on (see the deps command) and the fragment
+ *   contains the build statement producing the dyndep file as well. The phony meta target (when
+ *   specified) aggregates all the targets. */
+void print_ninja_targets(
+    const common::resource_set& resources, const std::filesystem::path& target_root_path,
+    const std::string_view& target_ext, const std::string& rule_name,
+    const std::optional<ninja_dyndep_edge>& dyndep,
+    const std::optional<std::string>& meta_target, std::ostream& os);
+
+} // namespace detail
+
 } // namespace person
 
 #endif // !defined PERSON_COMMAND_TARGETS_HPP
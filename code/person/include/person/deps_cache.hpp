@@ -0,0 +1,78 @@
+#if !defined PERSON_DEPS_CACHE_HPP
+#define PERSON_DEPS_CACHE_HPP
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/file_fingerprint.hpp"
+#include "common/file_system_utils.hpp"
+#include "common/rdf_term.hpp"
+
+namespace person
+{
+
+/** @brief The contribution of a single input file to the deps command results
+ *
+ *  The deps command needs just two things of the input data: the subjects described by every
+ *   file (see common::source_index) and the statements feeding the family graph (see
+ *   family_graph_builder::is_relevant). Both are extracted per file, so the contributions of the
+ *   unchanged files can be cached and merged with the freshly extracted contributions of the
+ *   changed files. The family graph is built from the merged statements, so the relationships
+ *   spanning multiple files are resolved the same way as in the loaded model. */
+struct deps_facts
+{
+    /** The distinct uri subjects of the file statements */
+    std::vector<std::string> subjects;
+    /** The file statements relevant to the family graph */
+    common::rdf_triple_buffer family_triples;
+
+    bool operator==(const deps_facts& other) const = default;
+};
+
+/** @brief Extract the deps facts of the statements parsed from a single file */
+deps_facts extract_deps_facts(const common::rdf_triple_buffer& triples);
+
+struct deps_cache_entry
+{
+    common::file_fingerprint fingerprint;
+    deps_facts facts;
+
+    bool operator==(const deps_cache_entry& other) const = default;
+};
+
+/** @brief The deps facts of the input files keyed by the file paths */
+using deps_cache = std::map<std::filesystem::path, deps_cache_entry>;
+
+/** @brief Read the deps cache file
+ *
+ *  The cache is a build artifact, so a missing, malformed or outdated cache file is not an error.
+ *   An empty cache is returned instead, which results in all the input files being re-parsed. */
+deps_cache read_deps_cache(const std::filesystem::path& cache_path);
+
+/** @brief Write the deps cache file (unless the file already has the very content)
+ *
+ *  @throws common::common_exception (general_runtime_error) on an output file operation failure */
+void write_deps_cache(const std::filesystem::path& cache_path, const deps_cache& cache);
+
+/** @brief Get the deps facts of the input files reusing the cached facts of the unchanged files
+ *
+ *  Only the new input files and the files whose fingerprints don't match the cache (see
+ *   common::is_file_unchanged) are parsed. The facts of the files no longer present in the input
+ *   set are dropped. The cache file is updated afterwards. The facts of the files failed to parse
+ *   (see common::parsed_rdf_file_cb) are returned, but not written to the cache file.
+ *
+ *  @param thread_count the number of threads parsing the changed files (see
+ *      common::parse_rdf_set)
+ *
+ *  @throws common::common_exception (general_runtime_error) on a file operation failure
+ *  @throws common::common_exception (redland_initialization_failed) when a parsing context can't
+ *      be initialized */
+deps_cache update_deps_cache(
+    const common::input_files& input_file_paths, unsigned int thread_count,
+    const std::filesystem::path& cache_path);
+
+} // namespace person
+
+#endif // !defined PERSON_DEPS_CACHE_HPP
@@ -0,0 +1,166 @@
+#if !defined PERSON_FAMILY_GRAPH_HPP
+#define PERSON_FAMILY_GRAPH_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <redland.h>
+
+#include "common/rdf_term.hpp"
+
+namespace person
+{
+
+/** @brief Dense identifier of a node of the family_graph (the index of the node uri) */
+using person_id = std::uint32_t;
+
+/** @brief Type tag of a family graph edge (the gx:type of the underlying gx:Relationship) */
+enum class family_edge_kind : std::uint8_t
+{
+    parent_child = 0,
+    couple,
+    /** Any other relationship type, including the relationships without the gx:type */
+    other
+};
+
+/** @brief Edge of the family graph pointing at the other end of a gx:Relationship */
+struct family_edge
+{
+    family_edge_kind kind;
+    person_id target;
+
+    bool operator==(const family_edge& other) const = default;
+    auto operator<=>(const family_edge& other) const = default;
+};
+
+/** @brief Immutable adjacency index of the gx:Relationship resources
+ *
+ *  The nodes of the graph are the gx:Person resources and the other uri resources referenced as
+ *   the gx:person1 or the gx:person2 of a relationship (e.g. the stubbed or the mistyped persons).
+ *   The is_person function tells the gx:Person nodes apart, so the lookups can reproduce the
+ *   queries either requiring the gx:Person type or reporting its absence.
+ *
+ *  The edges are stored in the compressed sparse row (CSR) form: the edges of all the nodes are
+ *   kept in a single array and the edges of a node occupy a contiguous range of the array
+ *   delimited by the offset array. There are two edge arrays: the outgoing edges lead from the
+ *   gx:person1 to the gx:person2 of a relationship, the incoming edges lead in the opposite
+ *   direction. The edges of a node are sorted by the kind and the target, so the edges of a
+ *   single kind form a contiguous subrange as well.
+ *
+ *  Duplicate relationships between the same nodes are collapsed into a single edge.
+ *
+ *  The nodes are numbered in the ascending order of their uris. The graph is never modified once
+ *   built, so it can be shared by threads. */
+class family_graph
+{
+public:
+    /** @brief Get the number of the nodes (the persons and the other relationship ends) */
+    [[nodiscard]] std::size_t get_node_count() const { return m_uris.size(); }
+    /** @brief Get the number of the gx:Person nodes */
+    [[nodiscard]] std::size_t get_person_count() const { return m_person_count; }
+    [[nodiscard]] std::size_t get_edge_count() const { return m_out_edges.size(); }
+
+    [[nodiscard]] std::optional<person_id> find_node(std::string_view uri) const;
+    [[nodiscard]] const std::string& get_uri(person_id id) const { return m_uris.at(id); }
+
+    /** @brief Check if the node is a gx:Person resource */
+    [[nodiscard]] bool is_person(person_id id) const { return (m_flags.at(id) & k_person_flag); }
+    /** @brief Check if the node has a gx:Gender of the gx:Male type */
+    [[nodiscard]] bool is_male(person_id id) const { return (m_flags.at(id) & k_male_flag); }
+    /** @brief Check if the node has a gx:Gender of the gx:Female type */
+    [[nodiscard]] bool is_female(person_id id) const { return (m_flags.at(id) & k_female_flag); }
+
+    /** @brief Get the gx:person2 ends of the relationships having the node as the gx:person1 */
+    [[nodiscard]] std::span<const family_edge> get_out_edges(person_id id) const;
+    /** @brief Get the gx:person1 ends of the relationships having the node as the gx:person2 */
+    [[nodiscard]] std::span<const family_edge> get_in_edges(person_id id) const;
+
+    [[nodiscard]] std::span<const family_edge> get_parents(person_id id) const;
+    [[nodiscard]] std::span<const family_edge> get_children(person_id id) const;
+    /** @brief Get the stated partners (the gx:Couple relationships in both directions) */
+    [[nodiscard]] std::vector<person_id> get_partners(person_id id) const;
+    /** @brief Get the inferred partners (the other parents of the children of the node) */
+    [[nodiscard]] std::vector<person_id> get_inferred_partners(person_id id) const;
+
+private:
+    friend class family_graph_builder;
+
+    static constexpr std::uint8_t k_person_flag = 0x01;
+    static constexpr std::uint8_t k_male_flag = 0x02;
+    static constexpr std::uint8_t k_female_flag = 0x04;
+
+    std::vector<std::string> m_uris;
+    std::vector<std::uint8_t> m_flags;
+    std::size_t m_person_count { 0 };
+    std::vector<std::uint32_t> m_out_offsets;
+    std::vector<family_edge> m_out_edges;
+    std::vector<std::uint32_t> m_in_offsets;
+    std::vector<family_edge> m_in_edges;
+};
+
+/** @brief Single pass builder of the family_graph
+ *
+ *  The builder is fed with the model statements in any order. It keeps only the statements
+ *   relevant to the family graph, so the whole model can be streamed through it. */
+class family_graph_builder
+{
+public:
+    /** @brief Check if the statement can contribute to the graph (the others are ignored)
+     *
+     *  The check allows the relevant statements to be kept (e.g. cached) apart from the model. */
+    [[nodiscard]] static bool is_relevant(const common::rdf_triple& triple);
+
+    void add_triple(const common::rdf_triple& triple);
+
+    /** @brief Build the graph from the statements added so far
+     *
+     *  The builder can't be reused after the call. */
+    [[nodiscard]] family_graph build();
+
+private:
+    struct relationship
+    {
+        bool is_relationship = false;
+        std::vector<std::string> person1;
+        std::vector<std::string> person2;
+        std::vector<family_edge_kind> kinds;
+    };
+
+    struct gender
+    {
+        bool is_gender = false;
+        std::uint8_t flags = 0;
+    };
+
+    std::unordered_set<std::string> m_persons;
+    std::unordered_map<common::rdf_term, relationship, common::rdf_term_hash> m_relationships;
+    /** The gx:gender objects keyed by the subject uris */
+    std::unordered_map<std::string, std::vector<common::rdf_term>> m_person_genders;
+    std::unordered_map<common::rdf_term, gender, common::rdf_term_hash> m_genders;
+};
+
+/** @brief Build the family graph of the model in a single statement pass
+ *
+ *  @throws common::common_exception (redland_unexpected_behavior) on the statement lookup
+ *      failure */
+family_graph build_family_graph(librdf_world* world, librdf_model* model);
+
+/** @brief Collect the pairs of related persons
+ *
+ *  The result is equivalent to the retrieve_related_persons query: a pair is returned if the two
+ *   persons are the ends of the same relationship (of any type) or if they are inferred partners
+ *   through a common child being a person as well. The nodes that aren't gx:Person resources are
+ *   never paired. Each unordered pair is returned once, with the lower identifier first. */
+std::vector<std::pair<person_id, person_id>> collect_related_person_pairs(
+    const family_graph& graph);
+
+} // namespace person
+
+#endif // !defined PERSON_FAMILY_GRAPH_HPP
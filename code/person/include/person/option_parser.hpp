@@ -1,6 +1,7 @@
 #if !defined PERSON_OPTION_PARSER_HPP
 #define PERSON_OPTION_PARSER_HPP
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -10,19 +11,58 @@
 #include <CLI/CLI.hpp>
 #include <spdlog/spdlog.h>
 
+#include "common/redland_utils.hpp"
+#include "person/queries/common.hpp"
+
 
 namespace person
 {
 
+/** @brief The output encoding of the list and details commands */
+enum class output_format : std::uint8_t
+{
+    /** The whole document indented by four spaces */
+    pretty = 0,
+    /** The whole document with no line breaks and no spaces */
+    compact,
+    /** One compact person object per line (newline delimited JSON) */
+    ndjson,
+    /** The CBOR (RFC 8949) encoding of the JSON document */
+    cbor,
+    /** The MessagePack encoding of the JSON document */
+    msgpack
+};
+
+/** @brief The build file syntax of the targets and deps commands output */
+enum class emit_format : std::uint8_t
+{
+    /** The make variable value (targets) and the make rules (deps) */
+    make = 0,
+    /** The build.ninja fragment (targets) and the ninja dyndep file (deps) */
+    ninja
+};
+
 struct cli_options
 {
     std::vector<std::string> input_paths;
     std::optional<std::string> base_path_raw;
+    std::optional<std::string> snapshot_path_raw;
+    std::optional<std::string> cache_path_raw;
+    unsigned int load_thread_count;
+    common::storage_backend storage_backend;
+    person::output_format output_format;
+    person::emit_format emit_format;
     spdlog::level::level_enum log_level;
 
     struct details
     {
         std::string person_uri;
+        bool all_flag;
+        std::optional<std::filesystem::path> person_list_path;
+        std::filesystem::path tgt_root_path;
+        unsigned int job_count;
+        unsigned int query_thread_count;
+        person::query_backend query_backend;
     } details_cmd;
 
     struct deps
@@ -30,6 +70,11 @@ struct cli_options
         std::string tgt_root_path;
         std::string meta_target;
         std::string person_uri;
+        bool all_flag;
+        bool json_flag;
+        bool html_flag;
+        std::optional<std::filesystem::path> output_path;
+        std::optional<std::filesystem::path> deps_cache_path;
     } deps_cmd;
 
     struct targets
@@ -37,7 +82,16 @@ struct cli_options
         bool json_flag;
         bool html_flag;
         std::filesystem::path tgt_root_path;
+        std::string rule_name;
+        std::optional<std::filesystem::path> dyndep_path;
+        std::string dyndep_rule_name;
+        std::optional<std::string> meta_target;
     } targets_cmd;
+
+    struct snapshot
+    {
+        std::filesystem::path output_path;
+    } snapshot_cmd;
 };
 
 struct cli_context
@@ -2,6 +2,9 @@
 #define PERSON_QUERIES_COMMON_HPP
 
 #include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
 
 #include <redland.h>
 #include <spdlog/spdlog.h>
@@ -18,6 +21,15 @@ enum class retrieve_result : std::uint8_t
     Success
 };
 
+/** @brief The implementation of the fixed graph pattern lookups (parents, partners, children) */
+enum class query_backend : std::uint8_t
+{
+    /** The SPARQL queries executed by the Redland query engine */
+    sparql = 0,
+    /** The lookups in the family_graph adjacency index (see family_graph.hpp) */
+    native
+};
+
 /** @brief Query caption data of the specified person resource
  *
  *  The caption data is the data needed by the common::Person::get_caption method.
@@ -85,20 +97,57 @@ std::shared_ptr<common::Person> retrieve_person_base_data_opt(
 std::shared_ptr<common::Person> retrieve_person_base_data_req(
     const std::string& person_uri, librdf_world* world, librdf_model* model);
 
+/** @brief Query the name of the specified person and store its parts in the person object
+ *
+ *  All the candidate names are retrieved in a single query. The preferred names take precedence
+ *   over the birth names, which take precedence over any other single name. A name is preferred
+ *   only when it has the exact `gx:preferred "true"^^xsd:boolean` statement (sameTerm, so the
+ *   equal values of other lexical forms such as "1"^^xsd:boolean don't count).
+ *
+ *  @return retrieve_result::Success if a properly formed name was found
+ *  @return retrieve_result::NotFound otherwise
+ *
+ *  @throws common::common_exception (redland_query_error) on an unexpected query execution error */
 retrieve_result retrieve_person_name(
     common::Person& person, librdf_world* world, librdf_model* model);
 
-retrieve_result retrieve_person_any_name(
-    common::Person& person, librdf_world* world, librdf_model* model);
+/** @brief Select the name part rows of a single person following the name precedence
+ *
+ *  The precedence is the same as the one of the retrieve_person_name function: the preferred
+ *   names come first, the birth names second, and any single name last.
+ *
+ *  @param name_table the name part rows of a single person as returned by the
+ *   retrieve_person_name_tables function
+ *
+ *  @return the rows of the selected names (empty if the person has no properly formed name) */
+common::data_table select_person_name_rows(const common::data_table& name_table);
 
-retrieve_result retrieve_person_birth_name(
-    common::Person& person, librdf_world* world, librdf_model* model);
+/** @brief Query the name parts of all the persons in a single query
+ *
+ *  Each row has the "name", "nameType", and "nameValue" bindings. The "preferred" and "birthName"
+ *   bindings are present if the name is marked as preferred or as a birth name respectively.
+ *
+ *  @param world the librdf world data (expected non-null)
+ *  @param model the librdf model data (expected non-null)
+ *
+ *  @return the name part rows grouped by the person uri
+ *
+ *  @throws common::common_exception (redland_query_error) on an unexpected query execution error */
+std::unordered_map<std::string, common::data_table> retrieve_person_name_tables(
+    librdf_world* world, librdf_model* model);
 
-retrieve_result retrieve_person_preferred_name(
-    common::Person& person, librdf_world* world, librdf_model* model);
+class person_identity_map;
+class family_graph;
 
+/** @brief Find the children of the person and the other parents of each child
+ *
+ *  @param[in] graph the family graph of the model used by the native backend (built from the
+ *      model if null).
+ */
 retrieve_result retrieve_person_children(
-    common::Person& person, librdf_world* world, librdf_model* model);
+    common::Person& person, librdf_world* world, librdf_model* model,
+    query_backend backend = query_backend::sparql, person_identity_map* identity_map = nullptr,
+    const family_graph* graph = nullptr);
 
 /**
  *
@@ -106,6 +155,20 @@ retrieve_result retrieve_person_children(
  */
 common::resource_set retrieve_person_uris(librdf_world* world, librdf_model* model);
 
+/** @brief Callback receiving the listed person (valid only during the call) */
+using person_list_visitor = std::function<void(const common::Person& person)>;
+
+/** @brief Stream the persons of the list (see retrieve_person_list) to the visitor
+ *
+ *  The persons are passed to the visitor as they are extracted from the query results, so the list
+ *   is never held in memory.
+ *
+ *  @return the number of the visited persons
+ *
+ *  @throws common::common_exception (redland_query_error) on the query execution error */
+std::size_t visit_person_list(
+    librdf_world* world, librdf_model* model, const person_list_visitor& visitor);
+
 std::vector<std::shared_ptr<common::Person>> retrieve_person_list(
     librdf_world* world, librdf_model* model);
 
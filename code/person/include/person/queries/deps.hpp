@@ -1,7 +1,9 @@
 #if !defined PERSON_QUERIES_DEPS_HPP
 #define PERSON_QUERIES_DEPS_HPP
 
+#include <functional>
 #include <memory>
+#include <string_view>
 
 #include <redland.h>
 
@@ -11,6 +13,18 @@
 namespace person
 {
 
+/** @brief Callback receiving a pair of related persons (the lower uri first) */
+using related_persons_visitor =
+    std::function<void(std::string_view person1_uri, std::string_view person2_uri)>;
+
+/** @brief Stream the pairs of related persons to the visitor without materializing them
+ *
+ *  The uri views are valid only during the visitor call.
+ *
+ *  @throws common::common_exception (redland_query_error) on the query execution error */
+std::size_t visit_related_persons(
+    librdf_world* world, librdf_model* model, const related_persons_visitor& visitor);
+
 common::data_table retrieve_related_persons(librdf_world* world, librdf_model* model);
 
 bool ask_resource_referenced(
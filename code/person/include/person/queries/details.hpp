@@ -1,11 +1,16 @@
 #if !defined PERSON_QUERIES_DETAILS_HPP
 #define PERSON_QUERIES_DETAILS_HPP
 
+#include <cstddef>
 #include <string_view>
+#include <vector>
 
-#include "common/person.hpp"
 #include "common/note.hpp"
+#include "common/person.hpp"
+#include "common/redland_utils.hpp"
+#include "person/family_graph.hpp"
 #include "person/queries/common.hpp"
+#include "person/queries/identity_map.hpp"
 
 
 namespace person
@@ -17,6 +22,10 @@ inline constexpr std::string_view k_invalid_stated_partner_note_id = "INVALID_ST
 inline constexpr std::string_view k_multiple_fathers_note_id = "MULTIPLE_FATHERS";
 inline constexpr std::string_view k_multiple_mothers_note_id = "MULTIPLE_MOTHERS";
 
+/* The native backend of the lookups below reads the family_graph of the model. The graph is built
+ *  once per command run and passed to the lookups; a lookup builds its own graph from the model
+ *  if none is passed (which costs a pass over all the statements). */
+
 /** @brief Find the father of the given person
  *
  *  Looks up the biological male parent (father) of the @p proband in the @p model and returns a
@@ -25,6 +34,9 @@ inline constexpr std::string_view k_multiple_mothers_note_id = "MULTIPLE_MOTHERS
  *  @param[in] proband The person whose father is being queried.
  *  @param[in] world the Redland RDF Library world owning the @p model.
  *  @param[in] model the Redland RDF Library model to query.
+ *  @param[in] backend the lookup implementation (the SPARQL query or the family graph lookup).
+ *  @param[in] identity_map the person cache of the command run (a local cache if null).
+ *  @param[in] graph the family graph of the model used by the native backend (built if null).
  *  @retval std::shared_ptr<common::Person> representing the father if found
  *  @retval nullptr if no father or more than one father was found
  *
@@ -33,7 +45,8 @@ inline constexpr std::string_view k_multiple_mothers_note_id = "MULTIPLE_MOTHERS
  */
 std::shared_ptr<common::Person> retrieve_person_father(
     const common::Person* proband, librdf_world* world, librdf_model* model,
-    std::vector<common::Note>& notes);
+    std::vector<common::Note>& notes, query_backend backend = query_backend::sparql,
+    person_identity_map* identity_map = nullptr, const family_graph* graph = nullptr);
 
 /** @brief Find the mother of the given person
  *
@@ -43,6 +56,9 @@ std::shared_ptr<common::Person> retrieve_person_father(
  *  @param[in] proband The person whose mother is being queried.
  *  @param[in] world the Redland RDF Library world owning the @p model.
  *  @param[in] model the Redland RDF Library model to query.
+ *  @param[in] backend the lookup implementation (the SPARQL query or the family graph lookup).
+ *  @param[in] identity_map the person cache of the command run (a local cache if null).
+ *  @param[in] graph the family graph of the model used by the native backend (built if null).
  *  @retval std::shared_ptr<common::Person> representing the mother if found
  *  @retval nullptr if no mother or more than one mother was found
  *
@@ -51,11 +67,80 @@ std::shared_ptr<common::Person> retrieve_person_father(
  */
 std::shared_ptr<common::Person> retrieve_person_mother(
     const common::Person* proband, librdf_world* world, librdf_model* model,
-    std::vector<common::Note>& notes);
+    std::vector<common::Note>& notes, query_backend backend = query_backend::sparql,
+    person_identity_map* identity_map = nullptr, const family_graph* graph = nullptr);
 
 std::vector<common::Person::PartnerRelation> retrieve_person_partners(
     const common::Person* proband, librdf_world* world, librdf_model* model,
-    std::vector<common::Note>& notes);
+    std::vector<common::Note>& notes, query_backend backend = query_backend::sparql,
+    person_identity_map* identity_map = nullptr, const family_graph* graph = nullptr);
+
+/** @brief The model copies running the relative lookups of the retrieve_person_relatives function
+ *
+ *  A Redland world can't be used by several threads at the same time, so every concurrent lookup
+ *   needs its own copy of the model. The pool holds the copies along with their identity maps.
+ *   The copies are filled once and reused by all the retrieve_person_relatives calls of the run,
+ *   so the copying is paid once per run rather than once per proband.
+ *
+ *  The pool is used by a single retrieve_person_relatives call at a time. */
+class relatives_lookup_pool
+{
+public:
+    /** @brief The greatest useful context count (the calling thread runs one of the lookups) */
+    static constexpr std::size_t k_max_context_count = 3;
+
+    /** @brief Create the empty contexts (see common::create_redland_ctx_copies)
+     *
+     *  @param context_count the number of the contexts (limited to k_max_context_count)
+     *
+     *  @throws common::common_exception when a context initialization fails */
+    relatives_lookup_pool(std::size_t context_count, common::storage_backend backend);
+
+    /** @brief Add the model statements (see common::find_triples) to all the contexts
+     *
+     *  @throws common::common_exception (redland_unexpected_behavior) when a statement can't be
+     *      added */
+    void fill(const common::rdf_triple_buffer& triples);
+
+    [[nodiscard]] std::size_t get_context_count() const { return m_ctxs.size(); }
+
+    /** @brief Get the identity map bound to the model copy of the context */
+    [[nodiscard]] person_identity_map& get_identity_map(std::size_t idx)
+    {
+        return m_identity_maps[idx];
+    }
+
+private:
+    std::vector<common::scoped_redland_ctx> m_ctxs;
+    std::vector<person_identity_map> m_identity_maps;
+};
+
+/** @brief The settings of the retrieve_person_relatives function */
+struct relatives_query_options
+{
+    query_backend backend = query_backend::sparql;
+    /** The family graph of the model used by the native backend (built per lookup if null) */
+    const family_graph* graph = nullptr;
+    /** The model copies running the lookups concurrently (the lookups are sequential if null) */
+    relatives_lookup_pool* pool = nullptr;
+};
+
+/** @brief Retrieve the father, the mother, the partners and the children of the proband
+ *
+ *  Without the lookup pool, the lookups are run in the calling thread in the father, mother,
+ *   partners, children order. With the pool, the father lookup is run in the calling thread and
+ *   the other lookups are spread over the pool contexts, one thread per context. The notes are
+ *   appended to the proband notes in the father, mother, partners order in both modes, so the
+ *   result doesn't depend on the pool.
+ *
+ *  @param[in] identity_map the person cache of the command run (a local cache if null), used by
+ *      the lookups run in the calling thread.
+ *
+ *  @throws the exception of the first failed lookup (in the above order)
+ */
+void retrieve_person_relatives(
+    common::Person& proband, librdf_world* world, librdf_model* model,
+    const relatives_query_options& options, person_identity_map* identity_map = nullptr);
 
 } // namespace person
 
@@ -0,0 +1,90 @@
+#if !defined PERSON_QUERIES_IDENTITY_MAP_HPP
+#define PERSON_QUERIES_IDENTITY_MAP_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <redland.h>
+
+#include "common/person.hpp"
+
+namespace person
+{
+
+/** @brief Per run cache of the materialized person resources keyed by the person uri
+ *
+ *  The same person is often retrieved several times during a single command run (e.g. as a
+ *   father, as a partner and as a co-parent of a child). The identity map retrieves each person
+ *   once and hands the same object back on the subsequent requests. A person retrieved with the
+ *   caption data only is upgraded in place to the base data when the base data is requested
+ *   later. The persons that weren't found are remembered as well.
+ *
+ *  The map is bound to a single model and isn't thread safe. */
+class person_identity_map
+{
+public:
+    person_identity_map(librdf_world* world, librdf_model* model);
+
+    /** @brief Get the person with the caption data (the name)
+     *
+     *  @return the person or nullptr if the person resource doesn't exist
+     *
+     *  @throws common::common_exception (redland_query_error) on the query execution error */
+    std::shared_ptr<common::Person> get_caption_data_opt(const std::string& person_uri);
+
+    /** @brief Get the person with the caption data (the name)
+     *
+     *  @throws common::common_exception (redland_query_error) on the query execution error
+     *  @throws person_exception (resource_not_found) on the resource not found */
+    std::shared_ptr<common::Person> get_caption_data_req(const std::string& person_uri);
+
+    /** @brief Get the persons with the caption data (the name)
+     *
+     *  @throws common::common_exception (redland_query_error) on the query execution error
+     *  @throws person_exception (resource_not_found) on any of the resources not found */
+    std::vector<std::shared_ptr<common::Person>> get_caption_data_seq_req(
+        const std::vector<std::string>& person_uri_seq);
+
+    /** @brief Get the person with the base data (the gender and the vital dates) and the name
+     *
+     *  @return the person or nullptr if the person resource doesn't exist
+     *
+     *  @throws common::common_exception (redland_query_error) on the query execution error */
+    std::shared_ptr<common::Person> get_base_data_opt(const std::string& person_uri);
+
+    /** @brief Get the person with the base data (the gender and the vital dates) and the name
+     *
+     *  @throws common::common_exception (redland_query_error) on the query execution error
+     *  @throws person_exception (resource_not_found) on the resource not found */
+    std::shared_ptr<common::Person> get_base_data_req(const std::string& person_uri);
+
+    [[nodiscard]] librdf_world* get_world() const { return m_world; }
+    [[nodiscard]] librdf_model* get_model() const { return m_model; }
+    /** @brief Get the number of the cached entries (including the missing persons) */
+    [[nodiscard]] std::size_t size() const { return m_entries.size(); }
+
+private:
+    enum class data_level : std::uint8_t
+    {
+        missing = 0,
+        caption,
+        base
+    };
+
+    struct entry
+    {
+        std::shared_ptr<common::Person> person;
+        data_level level;
+    };
+
+    librdf_world* m_world;
+    librdf_model* m_model;
+    std::unordered_map<std::string, entry> m_entries;
+};
+
+} // namespace person
+
+#endif // !defined PERSON_QUERIES_IDENTITY_MAP_HPP
@@ -1,6 +1,10 @@
 #include "person/command/common.hpp"
 
 #include "common/file_system_utils.hpp"
+#include "common/model_cache.hpp"
+#include "common/model_snapshot.hpp"
+#include "common/rdf_term.hpp"
+#include "common/source_index.hpp"
 
 namespace person
 {
@@ -23,18 +27,134 @@ common::input_files determine_input_paths(const cli_options& options)
 }
 
 
-common::scoped_redland_ctx load_input_data(const cli_options& options)
+common::scoped_redland_ctx load_input_data(
+    const cli_options& options, common::source_index* sources)
 {
     spdlog::trace("{}: Entry checkpoint", __func__);
 
-    common::input_files all_input_paths = determine_input_paths(options);
-
     common::scoped_redland_ctx redland_ctx = common::create_redland_ctx();
-    common::initialize_redland_ctx(redland_ctx); // throws common_exception on initialization failure
+    // throws common_exception on initialization failure
+    common::initialize_redland_ctx(redland_ctx, options.storage_backend);
+
+    if (options.snapshot_path_raw)
+    {
+        const common::scoped_model_snapshot snapshot =
+            common::open_model_snapshot(options.snapshot_path_raw.value());
+        common::load_model_snapshot(redland_ctx->world, redland_ctx->model, *snapshot);
+
+        if (sources)
+        {
+            *sources = common::build_source_index(*snapshot);
+        }
+    }
+    else if (options.cache_path_raw)
+    {
+        common::load_rdf_set_cached(
+            redland_ctx->world, redland_ctx->model, determine_input_paths(options),
+            options.load_thread_count, options.cache_path_raw.value());
+
+        // The cache snapshot is up to date once the model is loaded
+        if (sources)
+        {
+            const common::scoped_model_snapshot cache =
+                common::open_model_snapshot(options.cache_path_raw.value());
+            *sources = common::build_source_index(*cache);
+        }
+    }
+    else if (sources)
+    {
+        // The statements are recorded in the index right after being parsed
+        common::parse_rdf_set(
+            determine_input_paths(options), options.load_thread_count,
+            [&redland_ctx, sources](
+                std::size_t, const std::filesystem::path& file_path,
+                common::rdf_triple_buffer&& triples, bool) {
+                common::add_rdf_triples(redland_ctx->world, redland_ctx->model, triples);
+                sources->add_source(file_path, triples);
+            });
+    }
+    else
+    {
+        common::input_files all_input_paths = determine_input_paths(options);
 
-    common::load_rdf_set(redland_ctx->world, redland_ctx->model, all_input_paths);
+        common::load_rdf_set(
+            redland_ctx->world, redland_ctx->model, all_input_paths, options.load_thread_count);
+    }
 
     return redland_ctx;
 }
 
+std::optional<std::filesystem::path> get_model_snapshot_path(const cli_options& options)
+{
+    if (options.snapshot_path_raw)
+    {
+        return options.snapshot_path_raw.value();
+    }
+
+    if (options.cache_path_raw)
+    {
+        return options.cache_path_raw.value();
+    }
+
+    return std::nullopt;
+}
+
+int get_json_indent(output_format format)
+{
+    return (format == output_format::pretty ? 4 : -1);
+}
+
+bool is_binary_format(output_format format)
+{
+    return ((format == output_format::cbor) || (format == output_format::msgpack));
+}
+
+std::string get_output_extension(output_format format)
+{
+    switch (format)
+    {
+    case output_format::cbor: return "cbor";
+    case output_format::msgpack: return "msgpack";
+    default: return "json";
+    }
+}
+
+std::string encode_document(const nlohmann::json& document, output_format format)
+{
+    std::string result;
+
+    switch (format)
+    {
+    case output_format::cbor:
+        nlohmann::json::to_cbor(document, result);
+        break;
+    case output_format::msgpack:
+        nlohmann::json::to_msgpack(document, result);
+        break;
+    default:
+        result = document.dump(get_json_indent(format));
+        result += '\n';
+    }
+
+    return result;
+}
+
+std::string escape_ninja_path(std::string_view path)
+{
+    std::string result;
+    result.reserve(path.size());
+
+    for (const char c : path)
+    {
+        if ((c == ' ') || (c == ':') || (c == '$'))
+        {
+            result += '$';
+        }
+
+        result += c;
+    }
+
+    return result;
+}
+
 } // namespace person
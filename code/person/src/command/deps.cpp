@@ -1,14 +1,28 @@
 #include "person/command/deps.hpp"
 
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
+#include "common/common_exception.hpp"
 #include "common/file_system_utils.hpp"
+#include "common/graph_traversal.hpp"
 #include "common/person.hpp"
 #include "common/redland_utils.hpp"
+#include "common/source_index.hpp"
 #include "person/error.hpp"
 #include "person/command/common.hpp"
+#include "person/deps_cache.hpp"
+#include "person/family_graph.hpp"
 #include "person/queries/common.hpp"
 #include "person/queries/deps.hpp"
 
@@ -22,42 +36,39 @@ using person_deps_lut = std::map<common::Resource, std::set<common::Resource>>;
 
 
 void collect_dependent_resources(
-    librdf_world* world, librdf_model* model,
-    const common::resource_set& persons,
-    const std::filesystem::path& data_file_path,
+    const common::source_index& sources, const common::resource_set& persons,
     file_deps_lut& data_file_deps)
 {
     spdlog::debug(
-        "{}: Collecting list of resources dependent on the '{}' data file",
-        __func__, data_file_path);
+        "{}: Collecting the data files describing {} persons", __func__, persons.size());
+
+    std::vector<std::string> person_uris;
+    person_uris.reserve(persons.size());
 
     for (const auto& person : persons)
     {
-        if (ask_resource_referenced(world, model, person))
-        {
-            data_file_deps[*person].insert(data_file_path);
+        person_uris.emplace_back(person->get_uri_str());
+    }
 
-            spdlog::debug(
-                "{}: {} is referenced in {}",
-                __func__, person->get_unique_id(), data_file_path);
-        }
+    // A single pass intersection of the person set and the described subject set
+    for (auto& [person_uri, person_sources] : sources.intersect(std::move(person_uris)))
+    {
+        spdlog::debug(
+            "{}: {} is referenced in {} data files", __func__, person_uri, person_sources.size());
+
+        data_file_deps[common::Resource(person_uri)].merge(person_sources);
     }
 }
 
 
-person_deps_lut collect_dependent_persons(librdf_world* world, librdf_model* model)
+person_deps_lut collect_dependent_persons(const family_graph& graph)
 {
     person_deps_lut deps;
-    const common::data_table related_persons = retrieve_related_persons(world, model);
-    //const common::data_table indirect_partners = ...
 
-    for (const common::data_row& row : related_persons)
+    for (const auto& [id1, id2] : collect_related_person_pairs(graph))
     {
-        // The common::get_binding_value_req function throws the common::common_exception on a
-        //  missing binding and always returns a valid binding, so it is safe to use the arrow
-        //  operator on its result.
-        const common::Resource p1 { common::get_binding_value_req(row, "person1")->second };
-        const common::Resource p2 { common::get_binding_value_req(row, "person2")->second };
+        const common::Resource p1 { graph.get_uri(id1) };
+        const common::Resource p2 { graph.get_uri(id2) };
 
         deps[p1].insert(p2);
         deps[p2].insert(p1);
@@ -98,59 +109,214 @@ file_deps_lut merge_dependencies(
 void print_person_dependencies(
     const common::resource_id& person_id,
     const common::file_set& person_file_deps,
-    const std::filesystem::path& tgt_root_path)
+    const std::filesystem::path& tgt_root_path,
+    const std::string_view& target_ext,
+    const std::string& meta_target,
+    std::ostream& os)
 {
     spdlog::trace("{}: Entry checkpoint ({})", __func__, person_id);
 
-    const std::filesystem::path tgt_path = (tgt_root_path / person_id).replace_extension("json");
+    const std::filesystem::path tgt_path =
+        (tgt_root_path / person_id).replace_extension(target_ext);
 
     // The line-continuation character ('\') and the new-line character are added by the first
     //  dependency line printed in the following loop.
-    std::cout << tgt_path.string() << ":";
+    os << tgt_path.string() << ":";
 
     for (const auto& file : person_file_deps)
     {
-        std::cout << fmt::format(" \\\n\t\t{}", file);
+        os << fmt::format(" \\\n\t\t{}", file);
     }
 
     // The leading new-line characters are needed to close the last of the dependency lines
     //  printed in the above loop.
-    std::cout << fmt::format("\n\nint_person_all: {}\n\n", tgt_path.string());
+    os << fmt::format("\n\n{}: {}\n\n", meta_target, tgt_path.string());
 }
 
-} // namespace detail
+/** @brief Print the ninja dyndep entry of the person target
+ *
+ *  The entry adds the data files to the implicit inputs of the build statement of the target (see
+ *   the targets command), so the @p target_ext has to match the targets command one. The dyndep
+ *   file has to start with the version line (see print_dyndep_header). */
+void print_person_dyndep(
+    const common::resource_id& person_id,
+    const common::file_set& person_file_deps,
+    const std::filesystem::path& tgt_root_path,
+    const std::string_view& target_ext,
+    std::ostream& os)
+{
+    spdlog::trace("{}: Entry checkpoint ({})", __func__, person_id);
 
-void run_deps_command(const cli_options& options)
+    const std::filesystem::path tgt_path =
+        (tgt_root_path / person_id).replace_extension(target_ext);
+
+    os << fmt::format("build {}: dyndep", escape_ninja_path(tgt_path.string()));
+
+    if (!person_file_deps.empty())
+    {
+        os << " |";
+
+        for (const auto& file : person_file_deps)
+        {
+            os << fmt::format(" $\n    {}", escape_ninja_path(file.string()));
+        }
+    }
+
+    os << "\n\n";
+}
+
+void print_dyndep_header(std::ostream& os)
 {
-    spdlog::trace("{}: Entry checkpoint", __func__);
+    os << "ninja_dyndep_version = 1\n\n";
+}
 
-    detail::file_deps_lut data_file_lut;
-    detail::person_deps_lut person_deps;
+/** @brief Compute the data file dependencies of all the persons
+ *
+ *  The dependencies of a person are the data files describing the person and the persons related
+ *   to them (see merge_dependencies). */
+file_deps_lut compute_file_dependencies(const cli_options& options)
+{
+    file_deps_lut data_file_lut;
     common::resource_set all_persons;
+    common::source_index sources;
+    family_graph_builder builder;
+
+    if (options.deps_cmd.deps_cache_path && !options.snapshot_path_raw)
+    {
+        // The cached facts of the unchanged files are merged with the facts of the changed ones
+        const deps_cache cache = update_deps_cache(
+            determine_input_paths(options), options.load_thread_count,
+            options.deps_cmd.deps_cache_path.value());
 
-    common::input_files input_paths = determine_input_paths(options);
+        for (const auto& [path, entry] : cache)
+        {
+            sources.add_source(path, entry.facts.subjects);
 
+            for (const common::rdf_triple& triple : entry.facts.family_triples)
+            {
+                builder.add_triple(triple);
+            }
+        }
+    }
+    else
     {
-        common::scoped_redland_ctx redland_ctx = common::create_redland_ctx();
-        initialize_redland_ctx(redland_ctx); // throws common_exception on initialization failure
-        common::load_rdf_set(redland_ctx->world, redland_ctx->model, input_paths);
+        // The data file provenance is recorded during the load, so no data file is parsed again
+        common::scoped_redland_ctx redland_ctx = load_input_data(options, &sources);
 
-        all_persons = retrieve_person_uris(redland_ctx->world, redland_ctx->model);
-        person_deps = detail::collect_dependent_persons(redland_ctx->world, redland_ctx->model);
+        common::visit_triples(
+            redland_ctx->world, redland_ctx->model, {},
+            [&builder](const common::rdf_triple& triple) { builder.add_triple(triple); });
     }
 
-    for (const auto& path : input_paths)
+    // The family graph replaces the retrieve_related_persons query (see its documentation) and
+    //  its person nodes are the gx:Person resources (the same as the retrieve_person_uris ones)
+    const family_graph graph = builder.build();
+
+    for (person_id id = 0; id < graph.get_node_count(); ++id)
     {
-        common::scoped_redland_ctx redland_ctx = common::create_redland_ctx();
-        initialize_redland_ctx(redland_ctx); // throws common_exception on initialization failure
-        common::load_rdf(redland_ctx->world, redland_ctx->model, path.string());
+        if (graph.is_person(id))
+        {
+            all_persons.insert(std::make_shared<common::Resource>(graph.get_uri(id)));
+        }
+    }
 
-        detail::collect_dependent_resources(
-            redland_ctx->world, redland_ctx->model,
-            all_persons, path, data_file_lut);
+    collect_dependent_resources(sources, all_persons, data_file_lut);
+
+    return merge_dependencies(collect_dependent_persons(graph), data_file_lut);
+}
+
+/** @brief Pass the output stream to the writer
+ *
+ *  The make (or ninja dyndep) file is written to a temporary file which is renamed afterwards, so
+ *   the build tool never reads a partially written file. The standard output is used when there's
+ *   no output path.
+ *
+ *  @throws common::common_exception (general_runtime_error) on an output file operation failure */
+void write_make_file(
+    const std::optional<std::filesystem::path>& output_path,
+    const std::function<void(std::ostream&)>& writer)
+{
+    if (!output_path)
+    {
+        writer(std::cout);
+        return;
+    }
+
+    std::filesystem::path tmp_path = *output_path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream os(tmp_path, std::ios::trunc);
+        writer(os);
+        os.close();
+
+        if (!os)
+        {
+            throw common::common_exception(
+                common::common_exception::error_code::general_runtime_error,
+                fmt::format("Failed to write the '{}' make file", tmp_path));
+        }
     }
 
-    detail::file_deps_lut final_file_lut = detail::merge_dependencies(person_deps, data_file_lut);
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, *output_path, ec);
+
+    if (ec)
+    {
+        throw common::common_exception(
+            common::common_exception::error_code::general_runtime_error,
+            fmt::format("Failed to replace the '{}' make file", *output_path));
+    }
+}
+
+} // namespace detail
+
+void run_deps_command(const cli_options& options)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    const detail::file_deps_lut final_file_lut = detail::compute_file_dependencies(options);
+    const bool ninja_flag = (options.emit_format == emit_format::ninja);
+    const std::string target_ext = (options.deps_cmd.html_flag ? "html" : "json");
+
+    const auto print_dependencies =
+        [&](std::ostream& os, const common::Resource& person, const common::file_set& files) {
+            if (ninja_flag)
+            {
+                detail::print_person_dyndep(
+                    person.get_unique_id(), files, options.deps_cmd.tgt_root_path, target_ext,
+                    os);
+            }
+            else
+            {
+                detail::print_person_dependencies(
+                    person.get_unique_id(), files, options.deps_cmd.tgt_root_path, target_ext,
+                    options.deps_cmd.meta_target, os);
+            }
+        };
+
+    if (options.deps_cmd.all_flag)
+    {
+        // The whole corpus work is done once and the rules of all the persons are streamed
+        detail::write_make_file(
+            options.deps_cmd.output_path,
+            [&](std::ostream& os) {
+                if (ninja_flag)
+                {
+                    detail::print_dyndep_header(os);
+                }
+
+                for (const auto& [person, person_file_deps] : final_file_lut)
+                {
+                    print_dependencies(os, person, person_file_deps);
+                }
+            });
+
+        spdlog::info(
+            "{}: Written the dependencies of {} persons", __func__, final_file_lut.size());
+
+        return;
+    }
 
     common::Resource person = { options.deps_cmd.person_uri };
     const auto person_deps_it = final_file_lut.find(person);
@@ -162,10 +328,16 @@ void run_deps_command(const cli_options& options)
             fmt::format("Resource not found: {}", person.get_uri().buffer()));
     }
 
-    detail::print_person_dependencies(
-        person.get_unique_id(),
-        person_deps_it->second,
-        options.deps_cmd.tgt_root_path);
+    detail::write_make_file(
+        options.deps_cmd.output_path,
+        [&](std::ostream& os) {
+            if (ninja_flag)
+            {
+                detail::print_dyndep_header(os);
+            }
+
+            print_dependencies(os, person, person_deps_it->second);
+        });
 }
 
 } // namespace person
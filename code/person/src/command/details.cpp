@@ -1,19 +1,271 @@
 #include "person/command/details.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
 
+#include <fmt/format.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include "common/common_exception.hpp"
+#include "common/file_fingerprint.hpp"
+#include "common/graph_traversal.hpp"
 #include "common/person.hpp"
 #include "common/redland_utils.hpp"
 #include "person/command/common.hpp"
 #include "person/error.hpp"
+#include "person/family_graph.hpp"
 #include "person/queries/common.hpp"
 #include "person/queries/details.hpp"
+#include "person/queries/identity_map.hpp"
 
 namespace person
 {
+namespace detail
+{
+
+nlohmann::json retrieve_person_details(
+    const std::string& person_uri, librdf_world* world, librdf_model* model,
+    const relatives_query_options& options, person_identity_map& persons)
+{
+    // Exceptional path (resource not found): Propagate the exception
+    std::shared_ptr<common::Person> person =
+        retrieve_person_base_data_req(person_uri, world, model);
+
+    // Normal path (resource found): Continue the execution
+    retrieve_person_name(*person, world, model);
+
+    /* The proband is deliberately kept out of the identity map, so it can't become its own
+     * relative in a malformed data set. */
+    retrieve_person_relatives(*person, world, model, options, &persons);
+
+    return person_to_json(*person);
+}
+
+std::vector<std::string> read_person_uri_list(const std::filesystem::path& list_path)
+{
+    std::ifstream is(list_path);
+
+    if (!is)
+    {
+        throw common::common_exception(
+            common::common_exception::error_code::general_runtime_error,
+            fmt::format("Failed to open the '{}' person list file", list_path.string()));
+    }
+
+    std::vector<std::string> result;
+    std::string line;
+
+    while (std::getline(is, line))
+    {
+        const auto first = line.find_first_not_of(" \t\r");
+
+        if ((first == std::string::npos) || (line[first] == '#'))
+        {
+            continue;
+        }
+
+        const auto last = line.find_last_not_of(" \t\r");
+        result.emplace_back(line.substr(first, last - first + 1));
+    }
+
+    if (is.bad())
+    {
+        throw common::common_exception(
+            common::common_exception::error_code::general_runtime_error,
+            fmt::format("Failed to read the '{}' person list file", list_path.string()));
+    }
+
+    return result;
+}
+
+details_write_stats write_person_details(
+    const std::vector<std::string>& person_uris, librdf_world* world, librdf_model* model,
+    const std::filesystem::path& tgt_root_path, query_backend backend,
+    common::storage_backend storage_backend, unsigned int thread_count,
+    unsigned int query_thread_count, output_format format)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    const unsigned int worker_count = static_cast<unsigned int>(
+        std::min<std::size_t>(thread_count, std::max<std::size_t>(person_uris.size(), 1)));
+
+    spdlog::info(
+        "{}: Writing the details of {} person{} using {} thread{}",
+        __func__, person_uris.size(), (person_uris.size() == 1 ? "" : "s"),
+        worker_count, (worker_count == 1 ? "" : "s"));
+
+    /* The calling thread queries the loaded model directly, the other workers need their own
+     * copies. The copies are filled from the statement buffer, which is released as soon as the
+     * last copy is filled. */
+    std::vector<common::scoped_redland_ctx> ctxs;
+    common::rdf_triple_buffer triples;
+
+    if (worker_count > 1)
+    {
+        ctxs = common::create_redland_ctx_copies(worker_count - 1, storage_backend);
+    }
+
+    // Every worker runs the relative lookups on its own pool (created by the calling thread)
+    std::vector<relatives_lookup_pool> pools;
+
+    if (query_thread_count > 1)
+    {
+        pools.reserve(worker_count);
+
+        for (unsigned int idx = 0; idx < worker_count; ++idx)
+        {
+            pools.emplace_back(query_thread_count - 1, storage_backend);
+        }
+    }
+
+    if (!ctxs.empty() || !pools.empty())
+    {
+        triples = common::find_triples(world, model, {});
+    }
+
+    // The family graph is immutable, so the workers share the one built from the loaded model
+    std::optional<family_graph> graph;
+
+    if (backend == query_backend::native)
+    {
+        graph.emplace(build_family_graph(world, model));
+    }
+
+    const relatives_query_options query_options {
+        .backend = backend, .graph = (graph ? &*graph : nullptr) };
+    const std::string extension = get_output_extension(format);
+    std::atomic<std::size_t> next_person_idx = 0;
+    std::atomic<std::size_t> written_count = 0;
+    std::atomic<bool> stop_flag = false;
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+    std::mutex triples_mutex;
+    std::size_t pending_fill_count = worker_count;
+
+    // Fill the model copies of the worker (the last worker done with it releases the buffer)
+    const auto fill_worker_copies = [&](
+        common::redland_context* ctx, relatives_lookup_pool* pool) {
+        const auto release_triples = [&]() {
+            std::lock_guard<std::mutex> lock(triples_mutex);
+
+            if (--pending_fill_count == 0)
+            {
+                common::rdf_triple_buffer().swap(triples);
+            }
+        };
+
+        try
+        {
+            if (ctx)
+            {
+                common::fill_redland_ctx_copy(*ctx, triples); // throws common_exception
+            }
+
+            if (pool)
+            {
+                pool->fill(triples); // throws common_exception
+            }
+        }
+        catch (...)
+        {
+            release_triples();
+            throw;
+        }
+
+        release_triples();
+    };
+
+    // The worker queries the loaded model if no copy context is given
+    auto worker_fn = [&](common::redland_context* copy_ctx, relatives_lookup_pool* pool) {
+        try
+        {
+            fill_worker_copies(copy_ctx, pool);
+
+            librdf_world* worker_world = (copy_ctx ? copy_ctx->world : world);
+            librdf_model* worker_model = (copy_ctx ? copy_ctx->model : model);
+            relatives_query_options worker_options = query_options;
+            worker_options.pool = pool;
+
+            person_identity_map persons(worker_world, worker_model);
+
+            for (std::size_t idx = next_person_idx++;
+                 (idx < person_uris.size()) && !stop_flag; idx = next_person_idx++)
+            {
+                const common::Resource resource(person_uris[idx]);
+                const nlohmann::json details = retrieve_person_details(
+                    person_uris[idx], worker_world, worker_model, worker_options, persons);
+
+                const common::write_outcome outcome = common::write_file_if_changed(
+                    (tgt_root_path / resource.get_unique_id()).replace_extension(extension),
+                    encode_document(details, format));
+
+                if (outcome == common::write_outcome::written)
+                {
+                    ++written_count;
+                }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+
+            stop_flag = true;
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(ctxs.size());
+
+        // The worker of the calling thread takes the first pool
+        const auto get_pool = [&pools](std::size_t worker_idx) {
+            return (pools.empty() ? nullptr : &pools[worker_idx]);
+        };
+
+        for (std::size_t idx = 0; idx < ctxs.size(); ++idx)
+        {
+            workers.emplace_back(worker_fn, ctxs[idx].get(), get_pool(idx + 1));
+        }
+
+        worker_fn(nullptr, get_pool(0));
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+
+    const details_write_stats stats {
+        .written_count = written_count,
+        .unchanged_count = person_uris.size() - written_count
+    };
+
+    spdlog::info(
+        "{}: Written {} details file{}, skipped {} unchanged one{}", __func__,
+        stats.written_count, (stats.written_count == 1 ? "" : "s"),
+        stats.unchanged_count, (stats.unchanged_count == 1 ? "" : "s"));
+
+    return stats;
+}
+
+} // namespace detail
 
 void run_details_command(const cli_options& options)
 {
@@ -21,25 +273,64 @@ void run_details_command(const cli_options& options)
 
     common::scoped_redland_ctx redland_ctx = load_input_data(options);
 
-    const std::string person_uri { options.details_cmd.person_uri };
+    if (options.details_cmd.all_flag || options.details_cmd.person_list_path)
+    {
+        std::vector<std::string> person_uris;
 
-    // Exceptional path (resource not found): Propagate the exception
-    std::shared_ptr<common::Person> person = 
-        retrieve_person_base_data_req(person_uri, redland_ctx->world, redland_ctx->model);
+        if (options.details_cmd.person_list_path)
+        {
+            person_uris = detail::read_person_uri_list(*options.details_cmd.person_list_path);
+        }
+        else
+        {
+            for (const auto& resource :
+                     retrieve_person_uris(redland_ctx->world, redland_ctx->model))
+            {
+                person_uris.emplace_back(resource->get_uri_str());
+            }
+        }
 
-    // Normal path (resource found): Continue the execution
-    retrieve_person_name(*person, redland_ctx->world, redland_ctx->model);
-    person->father = retrieve_person_father(
-        person.get(), redland_ctx->world, redland_ctx->model, person->notes());
-    person->mother = retrieve_person_mother(
-        person.get(), redland_ctx->world, redland_ctx->model, person->notes());
-    person->partners = retrieve_person_partners(
-        person.get(), redland_ctx->world, redland_ctx->model, person->notes());
-
-    retrieve_person_children(*person, redland_ctx->world, redland_ctx->model);
-
-    nlohmann::json output = person_to_json(*person);
-    std::cout << output.dump(4) << '\n';
+        detail::write_person_details(
+            person_uris, redland_ctx->world, redland_ctx->model,
+            options.details_cmd.tgt_root_path, options.details_cmd.query_backend,
+            options.storage_backend, options.details_cmd.job_count,
+            options.details_cmd.query_thread_count, options.output_format);
+
+        return;
+    }
+
+    /* The relatives are materialized once per run (the identity map is shared by the relative
+     * lookups) */
+    person_identity_map persons(redland_ctx->world, redland_ctx->model);
+
+    // The family graph is built once for all the relative lookups of the native backend
+    std::optional<family_graph> graph;
+
+    if (options.details_cmd.query_backend == query_backend::native)
+    {
+        graph.emplace(build_family_graph(redland_ctx->world, redland_ctx->model));
+    }
+
+    // The model copies of the concurrent relative lookups
+    std::optional<relatives_lookup_pool> pool;
+
+    if (options.details_cmd.query_thread_count > 1)
+    {
+        pool.emplace(options.details_cmd.query_thread_count - 1, options.storage_backend);
+        pool->fill(common::find_triples(redland_ctx->world, redland_ctx->model, {}));
+    }
+
+    const nlohmann::json output = detail::retrieve_person_details(
+        options.details_cmd.person_uri, redland_ctx->world, redland_ctx->model,
+        {
+            .backend = options.details_cmd.query_backend,
+            .graph = (graph ? &*graph : nullptr),
+            .pool = (pool ? &*pool : nullptr)
+        },
+        persons);
+
+    const std::string encoded_output = encode_document(output, options.output_format);
+    std::cout.write(encoded_output.data(), static_cast<std::streamsize>(encoded_output.size()));
 }
 
 } // namespace person
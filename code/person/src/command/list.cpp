@@ -1,10 +1,13 @@
 #include "person/command/list.hpp"
 
 #include <iostream>
+#include <ostream>
+#include <string>
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include "common/json_writer.hpp"
 #include "common/person.hpp"
 #include "common/redland_utils.hpp"
 #include "person/command/common.hpp"
@@ -13,16 +16,136 @@
 namespace person
 {
 
+namespace detail
+{
+
+/** @brief Write the person list in the binary encoding
+ *
+ *  The CBOR array is written as the indefinite length one, so each person is encoded and written
+ *   as soon as it's extracted. The MessagePack array header carries the element count, so the
+ *   encoded persons are collected (in the compact binary form) before the array is written. The
+ *   empty list is encoded as null, the same as by the person_list_to_json function. */
+void write_binary_person_list(
+    librdf_world* world, librdf_model* model, output_format format, std::ostream& os)
+{
+    constexpr char k_cbor_indefinite_array = '\x9f';
+    constexpr char k_cbor_break = '\xff';
+
+    std::string buffer;
+    bool array_started = false;
+
+    const std::size_t person_count = visit_person_list(
+        world, model,
+        [&](const common::Person& person) {
+            const nlohmann::json document = common::person_to_json(person);
+
+            if (format == output_format::cbor)
+            {
+                if (!array_started)
+                {
+                    os.put(k_cbor_indefinite_array);
+                    array_started = true;
+                }
+
+                buffer.clear();
+                nlohmann::json::to_cbor(document, buffer);
+                os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            }
+            else
+            {
+                nlohmann::json::to_msgpack(document, buffer);
+            }
+        });
+
+    if (person_count == 0)
+    {
+        const std::string null_value = encode_document(nullptr, format);
+        os.write(null_value.data(), static_cast<std::streamsize>(null_value.size()));
+    }
+    else if (format == output_format::cbor)
+    {
+        os.put(k_cbor_break);
+    }
+    else
+    {
+        // The array header: fixarray, array 16 or array 32 (big endian element count)
+        std::string header;
+
+        if (person_count < 16)
+        {
+            header.push_back(static_cast<char>(0x90 | person_count));
+        }
+        else
+        {
+            const int size_bytes = (person_count <= 0xffff ? 2 : 4);
+            header.push_back(static_cast<char>(size_bytes == 2 ? 0xdc : 0xdd));
+
+            for (int idx = size_bytes - 1; idx >= 0; --idx)
+            {
+                header.push_back(static_cast<char>((person_count >> (idx * 8)) & 0xff));
+            }
+        }
+
+        os.write(header.data(), static_cast<std::streamsize>(header.size()));
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+}
+
+} // namespace detail
+
 void run_list_command(const cli_options& options)
 {
     spdlog::trace("{}: Entry checkpoint", __func__);
 
     common::scoped_redland_ctx redland_ctx = load_input_data(options);
 
-    auto persons = retrieve_person_list(redland_ctx->world, redland_ctx->model);
+    if (is_binary_format(options.output_format))
+    {
+        detail::write_binary_person_list(
+            redland_ctx->world, redland_ctx->model, options.output_format, std::cout);
+        return;
+    }
+
+    /* Each person is written as soon as it's extracted, so neither the person list nor its JSON
+     * document is held in memory. The pretty and compact outputs match the
+     * person_list_to_json(...).dump(indent) ones. */
+    common::json_writer writer(std::cout, get_json_indent(options.output_format));
+
+    if (options.output_format == output_format::ndjson)
+    {
+        // One person per line, so the downstream stages can process the persons incrementally
+        visit_person_list(
+            redland_ctx->world, redland_ctx->model,
+            [&writer](const common::Person& person) {
+                common::write_person_json(writer, person);
+                std::cout << '\n';
+            });
+
+        return;
+    }
+
+    const std::size_t person_count = visit_person_list(
+        redland_ctx->world, redland_ctx->model,
+        [&writer](const common::Person& person) {
+            if (writer.get_depth() == 0)
+            {
+                writer.begin_array();
+            }
+
+            common::write_person_json(writer, person);
+        });
+
+    if (person_count == 0)
+    {
+        // The empty person list is converted to the null JSON value
+        writer.null_value();
+    }
+    else
+    {
+        writer.end_array();
+    }
 
-    nlohmann::json output = person_list_to_json(persons);
-        std::cout << output.dump(4) << '\n';
+    std::cout << '\n';
 }
 
 } // namespace person
@@ -0,0 +1,53 @@
+#include "person/command/snapshot.hpp"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "common/common_exception.hpp"
+#include "common/file_system_utils.hpp"
+#include "common/model_snapshot.hpp"
+#include "common/redland_utils.hpp"
+#include "person/error.hpp"
+#include "person/command/common.hpp"
+
+namespace person
+{
+
+void run_snapshot_command(const cli_options& options)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    if (options.snapshot_path_raw)
+    {
+        throw person_exception(
+            person_exception::error_code::input_contract_error,
+            fmt::format(
+                "Precondition failure: snapshot={} must not be specified; the snapshot command"
+                " requires the turtle input files (-i or -s)",
+                options.snapshot_path_raw.value()));
+    }
+
+    common::model_snapshot_builder builder;
+
+    // The parsed files are delivered in the input order, so the snapshot content doesn't depend
+    //  on the number of the parsing threads
+    common::parse_rdf_set(
+        determine_input_paths(options), options.load_thread_count,
+        [&builder](
+            std::size_t, const std::filesystem::path& file_path,
+            common::rdf_triple_buffer&& triples, bool complete) {
+            if (!complete)
+            {
+                // The snapshot would be loaded in place of the file, so it must not be truncated
+                throw common::common_exception(
+                    common::common_exception::error_code::data_format_error,
+                    fmt::format("Failed to parse the '{}' input file", file_path.string()));
+            }
+
+            builder.add_source(file_path, triples);
+        });
+
+    builder.write(options.snapshot_cmd.output_path);
+}
+
+} // namespace person
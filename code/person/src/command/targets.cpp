@@ -1,6 +1,11 @@
 #include "person/command/targets.hpp"
 
 #include <iostream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
@@ -13,6 +18,30 @@ namespace person
 namespace detail
 {
 
+namespace
+{
+
+/** @brief Escape the ninja variable value (only the dollar sign has to be escaped there) */
+std::string escape_ninja_value(std::string_view value)
+{
+    std::string result;
+    result.reserve(value.size());
+
+    for (const char c : value)
+    {
+        if (c == '$')
+        {
+            result += '$';
+        }
+
+        result += c;
+    }
+
+    return result;
+}
+
+} // anonymous namespace
+
 void print_targets(
     const common::resource_set& resources, const std::filesystem::path& target_root_path,
     const std::string_view& target_ext)
@@ -37,21 +66,110 @@ void print_targets(
     std::cout << '\n';
 }
 
+void print_ninja_targets(
+    const common::resource_set& resources, const std::filesystem::path& target_root_path,
+    const std::string_view& target_ext, const std::string& rule_name,
+    const std::optional<ninja_dyndep_edge>& dyndep_edge,
+    const std::optional<std::string>& meta_target, std::ostream& os)
+{
+    std::optional<std::string> dyndep;
+
+    if (dyndep_edge)
+    {
+        dyndep = escape_ninja_path(dyndep_edge->path.string());
+
+        // Ninja requires the dyndep file to be produced by a build statement
+        os << fmt::format("build {}: {}", *dyndep, dyndep_edge->rule_name);
+
+        for (const auto& input_path : dyndep_edge->input_paths)
+        {
+            os << " $\n    " << escape_ninja_path(input_path.string());
+        }
+
+        os << "\n\n";
+    }
+
+    std::vector<std::string> tgt_paths;
+    tgt_paths.reserve(resources.size());
+
+    for (const auto& res : resources)
+    {
+        const std::filesystem::path tgt_path =
+            (target_root_path / res->get_unique_id()).replace_extension(target_ext);
+        const std::string& tgt = tgt_paths.emplace_back(escape_ninja_path(tgt_path.string()));
+
+        // The dyndep file has to be an input of the build statement, the order-only one suffices
+        os << fmt::format("build {}: {}", tgt, rule_name);
+
+        if (dyndep)
+        {
+            os << fmt::format(" || {}", *dyndep);
+        }
+
+        os << fmt::format("\n  person_uri = {}\n", escape_ninja_value(res->get_uri_str()));
+
+        if (dyndep)
+        {
+            os << fmt::format("  dyndep = {}\n", *dyndep);
+        }
+
+        os << '\n';
+    }
+
+    if (meta_target)
+    {
+        os << fmt::format("build {}: phony", escape_ninja_path(*meta_target));
+
+        for (const std::string& tgt : tgt_paths)
+        {
+            // The line continuation keeps the aggregate of many targets readable
+            os << " $\n    " << tgt;
+        }
+
+        os << '\n';
+    }
+}
+
 } // namespace detail
 
 void run_targets_command(const cli_options& options)
 {
     spdlog::trace("{}: Entry checkpoint", __func__);
 
-    common::input_files input_paths = determine_input_paths(options);
+    common::scoped_redland_ctx redland_ctx = load_input_data(options);
+
+    const std::string target_ext = (options.targets_cmd.json_flag ? "json" : "html");
+    const common::resource_set persons =
+        retrieve_person_uris(redland_ctx->world, redland_ctx->model);
 
-    common::scoped_redland_ctx redland_ctx = common::create_redland_ctx();
-    initialize_redland_ctx(redland_ctx); // throws common_exception on initialization failure
-    common::load_rdf_set(redland_ctx->world, redland_ctx->model, input_paths);
+    if (options.emit_format == emit_format::ninja)
+    {
+        const std::string rule_name =
+            (options.targets_cmd.rule_name.empty()
+             ? "person_" + target_ext : options.targets_cmd.rule_name);
+        std::optional<detail::ninja_dyndep_edge> dyndep_edge;
+
+        if (options.targets_cmd.dyndep_path)
+        {
+            // The dyndep file is derived from the same input data as the targets
+            dyndep_edge = detail::ninja_dyndep_edge {
+                .path = *options.targets_cmd.dyndep_path,
+                .rule_name = options.targets_cmd.dyndep_rule_name,
+                .input_paths =
+                    (options.snapshot_path_raw
+                     ? common::file_set { *options.snapshot_path_raw }
+                     : determine_input_paths(options))
+            };
+        }
+
+        detail::print_ninja_targets(
+            persons, options.targets_cmd.tgt_root_path, target_ext, rule_name, dyndep_edge,
+            options.targets_cmd.meta_target, std::cout);
+
+        return;
+    }
 
-    detail::print_targets(
-        retrieve_person_uris(redland_ctx->world, redland_ctx->model),
-        options.targets_cmd.tgt_root_path, (options.targets_cmd.json_flag ? "json" : "html"));
+    detail::print_targets(persons, options.targets_cmd.tgt_root_path, target_ext);
 }
 
 } // namespace person
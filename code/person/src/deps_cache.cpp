@@ -0,0 +1,252 @@
+#include "person/deps_cache.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "common/redland_utils.hpp"
+#include "person/family_graph.hpp"
+
+namespace person
+{
+
+namespace
+{
+
+constexpr int k_deps_cache_version = 2;
+
+nlohmann::json term_to_json(const common::rdf_term& term)
+{
+    nlohmann::json result = { static_cast<int>(term.type), term.value };
+
+    if (!term.datatype.empty() || !term.language.empty())
+    {
+        result.push_back(term.datatype);
+        result.push_back(term.language);
+    }
+
+    return result;
+}
+
+common::rdf_term term_from_json(const nlohmann::json& doc)
+{
+    common::rdf_term result;
+
+    const int type = doc.at(0).get<int>();
+
+    if ((type < static_cast<int>(common::rdf_term::kind::uri)) ||
+        (type > static_cast<int>(common::rdf_term::kind::blank)))
+    {
+        throw nlohmann::json::other_error::create(
+            501, fmt::format("Unexpected term type: {}", type), &doc);
+    }
+
+    result.type = static_cast<common::rdf_term::kind>(type);
+    result.value = doc.at(1).get<std::string>();
+
+    if (doc.size() > 2)
+    {
+        result.datatype = doc.at(2).get<std::string>();
+        result.language = doc.at(3).get<std::string>();
+    }
+
+    return result;
+}
+
+} // anonymous namespace
+
+deps_facts extract_deps_facts(const common::rdf_triple_buffer& triples)
+{
+    deps_facts result;
+    std::unordered_set<std::string> subjects;
+
+    for (const common::rdf_triple& triple : triples)
+    {
+        if ((triple.subject.type == common::rdf_term::kind::uri) &&
+            subjects.insert(triple.subject.value).second)
+        {
+            result.subjects.push_back(triple.subject.value);
+        }
+
+        if (family_graph_builder::is_relevant(triple))
+        {
+            result.family_triples.push_back(triple);
+        }
+    }
+
+    return result;
+}
+
+deps_cache read_deps_cache(const std::filesystem::path& cache_path)
+{
+    std::ifstream is(cache_path, std::ios::binary);
+
+    if (!is)
+    {
+        spdlog::debug("{}: The '{}' deps cache doesn't exist", __func__, cache_path);
+
+        return {};
+    }
+
+    deps_cache result;
+
+    try
+    {
+        const nlohmann::json doc = nlohmann::json::from_cbor(
+            std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+
+        if (doc.at("version").get<int>() != k_deps_cache_version)
+        {
+            spdlog::warn(
+                "{}: Ignoring the '{}' deps cache of unsupported version", __func__, cache_path);
+
+            return {};
+        }
+
+        for (const auto& file : doc.at("files"))
+        {
+            deps_cache_entry entry;
+            entry.fingerprint.size = file.at("size").get<std::uint64_t>();
+            entry.fingerprint.mtime = file.at("mtime").get<std::int64_t>();
+            entry.fingerprint.content_hash = file.at("hash").get<std::uint64_t>();
+            entry.facts.subjects = file.at("subjects").get<std::vector<std::string>>();
+
+            for (const auto& triple : file.at("triples"))
+            {
+                entry.facts.family_triples.push_back({
+                        term_from_json(triple.at(0)), term_from_json(triple.at(1)),
+                        term_from_json(triple.at(2)) });
+            }
+
+            result.emplace(file.at("path").get<std::string>(), std::move(entry));
+        }
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        spdlog::warn(
+            "{}: Ignoring the malformed '{}' deps cache: {}", __func__, cache_path, e.what());
+
+        return {};
+    }
+
+    return result;
+}
+
+void write_deps_cache(const std::filesystem::path& cache_path, const deps_cache& cache)
+{
+    nlohmann::json doc;
+    doc["version"] = k_deps_cache_version;
+    doc["files"] = nlohmann::json::array();
+
+    for (const auto& [path, entry] : cache)
+    {
+        nlohmann::json triples = nlohmann::json::array();
+
+        for (const common::rdf_triple& triple : entry.facts.family_triples)
+        {
+            triples.push_back({
+                    term_to_json(triple.subject), term_to_json(triple.predicate),
+                    term_to_json(triple.object) });
+        }
+
+        doc["files"].push_back({
+                { "path", path.string() },
+                { "size", entry.fingerprint.size },
+                { "mtime", entry.fingerprint.mtime },
+                { "hash", entry.fingerprint.content_hash },
+                { "subjects", entry.facts.subjects },
+                { "triples", std::move(triples) }
+            });
+    }
+
+    // The binary encoding keeps the cache reading cheap (the cache is read on every deps run)
+    std::string encoded_doc;
+    nlohmann::json::to_cbor(doc, encoded_doc);
+
+    common::write_file_if_changed(cache_path, encoded_doc);
+}
+
+deps_cache update_deps_cache(
+    const common::input_files& input_file_paths, unsigned int thread_count,
+    const std::filesystem::path& cache_path)
+{
+    spdlog::trace("{}: Entry checkpoint ({})", __func__, cache_path);
+
+    deps_cache old_cache = read_deps_cache(cache_path);
+    deps_cache new_cache;
+    common::input_files changed_files;
+    bool cache_refreshed = false;
+
+    for (const auto& path : input_file_paths)
+    {
+        const auto cache_it = old_cache.find(path);
+
+        if (cache_it != old_cache.end())
+        {
+            const common::file_fingerprint old_fingerprint = cache_it->second.fingerprint;
+
+            if (common::is_file_unchanged(path, cache_it->second.fingerprint))
+            {
+                cache_refreshed |= !(cache_it->second.fingerprint == old_fingerprint);
+                new_cache.emplace(path, std::move(cache_it->second));
+                continue;
+            }
+        }
+
+        changed_files.insert(path);
+    }
+
+    const std::size_t dropped_count = old_cache.size() - new_cache.size();
+
+    spdlog::info(
+        "{}: {} unchanged, {} new or changed and {} removed or changed input files",
+        __func__, new_cache.size(), changed_files.size(), dropped_count);
+
+    if (changed_files.empty() && (dropped_count == 0) && !cache_refreshed)
+    {
+        return new_cache;
+    }
+
+    // The fingerprints are taken before parsing, so a file modified in the meantime is re-parsed
+    //  on the next run rather than cached with the outdated facts
+    for (const auto& path : changed_files)
+    {
+        new_cache[path].fingerprint = common::fingerprint_file(path);
+    }
+
+    std::vector<deps_cache::node_type> failed_entries;
+
+    if (!changed_files.empty())
+    {
+        common::parse_rdf_set(
+            changed_files, thread_count,
+            [&new_cache, &failed_entries](
+                std::size_t, const std::filesystem::path& file_path,
+                common::rdf_triple_buffer&& triples, bool complete) {
+                new_cache[file_path].facts = extract_deps_facts(triples);
+
+                if (!complete)
+                {
+                    failed_entries.push_back(new_cache.extract(file_path));
+                }
+            });
+    }
+
+    write_deps_cache(cache_path, new_cache);
+
+    // The facts of the files failed to parse are used by this run only, so the files are parsed
+    //  again on the next run rather than being cached with the truncated facts
+    for (auto& entry : failed_entries)
+    {
+        new_cache.insert(std::move(entry));
+    }
+
+    return new_cache;
+}
+
+} // namespace person
@@ -0,0 +1,386 @@
+#include "person/family_graph.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "common/graph_traversal.hpp"
+
+namespace person
+{
+
+namespace
+{
+
+constexpr std::string_view k_rdf_type = "http://www.w3.org/1999/02/22-rdf-syntax-ns#type";
+constexpr std::string_view k_gx_couple = "http://gedcomx.org/Couple";
+constexpr std::string_view k_gx_female = "http://gedcomx.org/Female";
+constexpr std::string_view k_gx_gender = "http://gedcomx.org/gender";
+constexpr std::string_view k_gx_gender_class = "http://gedcomx.org/Gender";
+constexpr std::string_view k_gx_male = "http://gedcomx.org/Male";
+constexpr std::string_view k_gx_parent_child = "http://gedcomx.org/ParentChild";
+constexpr std::string_view k_gx_person = "http://gedcomx.org/Person";
+constexpr std::string_view k_gx_person1 = "http://gedcomx.org/person1";
+constexpr std::string_view k_gx_person2 = "http://gedcomx.org/person2";
+constexpr std::string_view k_gx_relationship = "http://gedcomx.org/Relationship";
+constexpr std::string_view k_gx_type = "http://gedcomx.org/type";
+
+family_edge_kind to_edge_kind(const common::rdf_term& type)
+{
+    if (type.value == k_gx_parent_child)
+    {
+        return family_edge_kind::parent_child;
+    }
+
+    if (type.value == k_gx_couple)
+    {
+        return family_edge_kind::couple;
+    }
+
+    return family_edge_kind::other;
+}
+
+std::span<const family_edge> get_row(
+    const std::vector<std::uint32_t>& offsets, const std::vector<family_edge>& edges,
+    person_id id)
+{
+    return std::span<const family_edge>(edges).subspan(
+        offsets.at(id), offsets.at(id + 1) - offsets.at(id));
+}
+
+std::span<const family_edge> get_kind_range(
+    std::span<const family_edge> row, family_edge_kind kind)
+{
+    const auto [first, last] = std::ranges::equal_range(
+        row, kind, std::less<>{}, [](const family_edge& edge) { return edge.kind; });
+
+    return { first, last };
+}
+
+/** @brief Compress the (source, edge) pairs into the CSR offset and edge arrays */
+void compress_edges(
+    std::vector<std::pair<person_id, family_edge>>& pairs, std::size_t node_count,
+    std::vector<std::uint32_t>& offsets, std::vector<family_edge>& edges)
+{
+    std::ranges::sort(pairs);
+    const auto duplicates = std::ranges::unique(pairs);
+    pairs.erase(duplicates.begin(), duplicates.end());
+
+    offsets.assign(node_count + 1, 0);
+    edges.clear();
+    edges.reserve(pairs.size());
+
+    for (const auto& [source, edge] : pairs)
+    {
+        ++offsets[source + 1];
+        edges.push_back(edge);
+    }
+
+    for (std::size_t idx = 1; idx < offsets.size(); ++idx)
+    {
+        offsets[idx] += offsets[idx - 1];
+    }
+}
+
+} // anonymous namespace
+
+std::optional<person_id> family_graph::find_node(std::string_view uri) const
+{
+    const auto it = std::ranges::lower_bound(m_uris, uri);
+
+    if ((it == m_uris.end()) || (*it != uri))
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<person_id>(it - m_uris.begin());
+}
+
+std::span<const family_edge> family_graph::get_out_edges(person_id id) const
+{
+    return get_row(m_out_offsets, m_out_edges, id);
+}
+
+std::span<const family_edge> family_graph::get_in_edges(person_id id) const
+{
+    return get_row(m_in_offsets, m_in_edges, id);
+}
+
+std::span<const family_edge> family_graph::get_parents(person_id id) const
+{
+    return get_kind_range(get_in_edges(id), family_edge_kind::parent_child);
+}
+
+std::span<const family_edge> family_graph::get_children(person_id id) const
+{
+    return get_kind_range(get_out_edges(id), family_edge_kind::parent_child);
+}
+
+std::vector<person_id> family_graph::get_partners(person_id id) const
+{
+    std::vector<person_id> result;
+
+    for (const family_edge& edge : get_kind_range(get_out_edges(id), family_edge_kind::couple))
+    {
+        result.push_back(edge.target);
+    }
+
+    for (const family_edge& edge : get_kind_range(get_in_edges(id), family_edge_kind::couple))
+    {
+        result.push_back(edge.target);
+    }
+
+    std::ranges::sort(result);
+    const auto duplicates = std::ranges::unique(result);
+    result.erase(duplicates.begin(), duplicates.end());
+    std::erase(result, id);
+
+    return result;
+}
+
+std::vector<person_id> family_graph::get_inferred_partners(person_id id) const
+{
+    std::vector<person_id> result;
+
+    for (const family_edge& child : get_children(id))
+    {
+        for (const family_edge& parent : get_parents(child.target))
+        {
+            if (parent.target != id)
+            {
+                result.push_back(parent.target);
+            }
+        }
+    }
+
+    std::ranges::sort(result);
+    const auto duplicates = std::ranges::unique(result);
+    result.erase(duplicates.begin(), duplicates.end());
+
+    return result;
+}
+
+bool family_graph_builder::is_relevant(const common::rdf_triple& triple)
+{
+    const std::string& predicate = triple.predicate.value;
+
+    if (predicate == k_rdf_type)
+    {
+        return ((triple.object.value == k_gx_person) ||
+                (triple.object.value == k_gx_relationship) ||
+                (triple.object.value == k_gx_gender_class));
+    }
+
+    return ((predicate == k_gx_person1) || (predicate == k_gx_person2) ||
+            (predicate == k_gx_type) || (predicate == k_gx_gender));
+}
+
+void family_graph_builder::add_triple(const common::rdf_triple& triple)
+{
+    const std::string& predicate = triple.predicate.value;
+
+    if (predicate == k_rdf_type)
+    {
+        if (triple.object.value == k_gx_person)
+        {
+            m_persons.insert(triple.subject.value);
+        }
+        else if (triple.object.value == k_gx_relationship)
+        {
+            m_relationships[triple.subject].is_relationship = true;
+        }
+        else if (triple.object.value == k_gx_gender_class)
+        {
+            m_genders[triple.subject].is_gender = true;
+        }
+    }
+    else if (predicate == k_gx_person1)
+    {
+        m_relationships[triple.subject].person1.push_back(triple.object.value);
+    }
+    else if (predicate == k_gx_person2)
+    {
+        m_relationships[triple.subject].person2.push_back(triple.object.value);
+    }
+    else if (predicate == k_gx_type)
+    {
+        /* The gx:type predicate is shared by many GEDCOM X classes. The types of the resources
+         * that turn out not to be relationships are dropped by the build function. */
+        m_relationships[triple.subject].kinds.push_back(to_edge_kind(triple.object));
+
+        if (triple.object.value == k_gx_male)
+        {
+            m_genders[triple.subject].flags |= family_graph::k_male_flag;
+        }
+        else if (triple.object.value == k_gx_female)
+        {
+            m_genders[triple.subject].flags |= family_graph::k_female_flag;
+        }
+    }
+    else if (predicate == k_gx_gender)
+    {
+        m_person_genders[triple.subject.value].push_back(triple.object);
+    }
+}
+
+family_graph family_graph_builder::build()
+{
+    family_graph graph;
+
+    /* The nodes are the persons and the uri ends of the relationships. The blank node ends can't
+     * be referenced by the lookups, so they aren't indexed. */
+    std::erase_if(m_relationships, [](const auto& item) { return !item.second.is_relationship; });
+
+    std::unordered_set<std::string> nodes = m_persons;
+
+    for (const auto& [node, rel] : m_relationships)
+    {
+        nodes.insert(rel.person1.begin(), rel.person1.end());
+        nodes.insert(rel.person2.begin(), rel.person2.end());
+    }
+
+    graph.m_uris.assign(nodes.begin(), nodes.end());
+    std::ranges::sort(graph.m_uris);
+    graph.m_flags.assign(graph.m_uris.size(), 0);
+
+    for (person_id id = 0; id < graph.m_uris.size(); ++id)
+    {
+        const std::string& uri = graph.m_uris[id];
+        std::uint8_t& flags = graph.m_flags[id];
+
+        if (m_persons.contains(uri))
+        {
+            flags |= family_graph::k_person_flag;
+            ++graph.m_person_count;
+        }
+
+        const auto genders_it = m_person_genders.find(uri);
+
+        if (genders_it == m_person_genders.end())
+        {
+            continue;
+        }
+
+        for (const common::rdf_term& gender_node : genders_it->second)
+        {
+            const auto gender_it = m_genders.find(gender_node);
+
+            if ((gender_it != m_genders.end()) && gender_it->second.is_gender)
+            {
+                flags |= gender_it->second.flags;
+            }
+        }
+    }
+
+    std::vector<std::pair<person_id, family_edge>> out_pairs;
+    std::vector<std::pair<person_id, family_edge>> in_pairs;
+
+    for (auto& [node, rel] : m_relationships)
+    {
+
+        if (rel.kinds.empty())
+        {
+            rel.kinds.push_back(family_edge_kind::other);
+        }
+
+        for (const std::string& uri1 : rel.person1)
+        {
+            const std::optional<person_id> id1 = graph.find_node(uri1);
+
+            for (const std::string& uri2 : rel.person2)
+            {
+                const std::optional<person_id> id2 = graph.find_node(uri2);
+
+                if (!id1 || !id2)
+                {
+                    continue;
+                }
+
+                for (const family_edge_kind kind : rel.kinds)
+                {
+                    out_pairs.push_back({ *id1, { .kind=kind, .target=*id2 } });
+                    in_pairs.push_back({ *id2, { .kind=kind, .target=*id1 } });
+                }
+            }
+        }
+    }
+
+    compress_edges(out_pairs, graph.m_uris.size(), graph.m_out_offsets, graph.m_out_edges);
+    compress_edges(in_pairs, graph.m_uris.size(), graph.m_in_offsets, graph.m_in_edges);
+
+    m_persons.clear();
+    m_relationships.clear();
+    m_person_genders.clear();
+    m_genders.clear();
+
+    spdlog::debug(
+        "{}: Built the family graph of {} nodes ({} persons) and {} edges", __func__,
+        graph.get_node_count(), graph.get_person_count(), graph.get_edge_count());
+
+    return graph;
+}
+
+family_graph build_family_graph(librdf_world* world, librdf_model* model)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    family_graph_builder builder;
+
+    common::visit_triples(
+        world, model, {},
+        [&builder](const common::rdf_triple& triple) { builder.add_triple(triple); });
+
+    return builder.build();
+}
+
+std::vector<std::pair<person_id, person_id>> collect_related_person_pairs(
+    const family_graph& graph)
+{
+    std::set<std::pair<person_id, person_id>> pairs;
+
+    const auto insert_pair = [&pairs](person_id a, person_id b) {
+        if (a != b)
+        {
+            pairs.insert(std::minmax(a, b));
+        }
+    };
+
+    for (person_id id = 0; id < graph.get_node_count(); ++id)
+    {
+        if (!graph.is_person(id))
+        {
+            continue;
+        }
+
+        for (const family_edge& edge : graph.get_out_edges(id))
+        {
+            if (graph.is_person(edge.target))
+            {
+                insert_pair(id, edge.target);
+            }
+        }
+
+        // The inferred partners must share a child being a person
+        for (const family_edge& child : graph.get_children(id))
+        {
+            if (!graph.is_person(child.target))
+            {
+                continue;
+            }
+
+            for (const family_edge& parent : graph.get_parents(child.target))
+            {
+                if (graph.is_person(parent.target))
+                {
+                    insert_pair(id, parent.target);
+                }
+            }
+        }
+    }
+
+    return { pairs.begin(), pairs.end() };
+}
+
+} // namespace person
@@ -20,6 +20,7 @@
 #include "person/command/deps.hpp"
 #include "person/command/details.hpp"
 #include "person/command/list.hpp"
+#include "person/command/snapshot.hpp"
 #include "person/command/targets.hpp"
 
 
@@ -53,6 +54,10 @@ int run_main(int argc, char** argv) {
     {
         person::run_targets_command(cli_ctx.options);
     }
+    else if (cli_ctx.parser->got_subcommand("snapshot"))
+    {
+        person::run_snapshot_command(cli_ctx.options);
+    }
 
     return 0;
 }
@@ -1,5 +1,8 @@
 #include "person/option_parser.hpp"
 
+#include <map>
+#include <string>
+
 #include "common/command_line_utils.hpp"
 #include "common/spdlog_utils.hpp"
 
@@ -17,37 +20,170 @@ cli_context init_cli_context(spdlog::level::level_enum default_log_level)
     CLI::Option_group* input_grp =
         result.parser->add_option_group("Input Data", "Input data source paths");
 
-    input_grp->add_option(
+    CLI::Option* input_opt = input_grp->add_option(
         "-i,--input", result.options.input_paths,
         "Path to an individual turtle file to be loaded into the RDF model");
-    input_grp->add_option(
+    CLI::Option* src_root_opt = input_grp->add_option(
         "-s,--src-root-path", result.options.base_path_raw,
         "The source root PATH to be searched for the turtle files to be loaded into the RDF model")
         ->option_text("PATH")
         ->check(common::validate_existing_dir_path);
+    CLI::Option* snapshot_opt = input_grp->add_option(
+        "--snapshot", result.options.snapshot_path_raw,
+        "The PATH of a model snapshot (created by the snapshot command) to be loaded into the RDF"
+        " model instead of the turtle files")
+        ->option_text("PATH")
+        ->check(CLI::ExistingFile)
+        ->excludes(input_opt)
+        ->excludes(src_root_opt);
     input_grp->require_option();
 
+    result.parser->add_option(
+        "--cache", result.options.cache_path_raw,
+        "The PATH of the model cache. Only the turtle files changed since the cache was updated"
+        " are parsed. The cache is created when it doesn't exist.")
+        ->option_text("PATH")
+        ->excludes(snapshot_opt);
+
+    result.parser->add_option(
+        "--load-threads", result.options.load_thread_count,
+        "The number N of threads parsing the input turtle files concurrently. The value of 0"
+        " selects the number of hardware threads. The default is 1 (sequential loading).")
+        ->option_text("N")
+        ->default_val(1)
+        ->check(CLI::NonNegativeNumber);
+
+    const std::map<std::string, common::storage_backend> storage_backend_map {
+        { "memory", common::storage_backend::memory },
+        { "native", common::storage_backend::native }
+    };
+
+    result.parser->add_option(
+        "--storage", result.options.storage_backend,
+        "The RDF model storage NAME. One of {memory, native}. The 'native' storage indexes the"
+        " statements for faster lookups. The default is 'memory'.")
+        ->option_text("NAME")
+        ->default_val(common::storage_backend::memory)
+        ->transform(CLI::CheckedTransformer(storage_backend_map, CLI::ignore_case));
+
     common::add_log_level_cli_option(
         result.parser.get(), result.options.log_level, default_log_level);
 
+    const std::map<std::string, output_format> output_format_map {
+        { "pretty", output_format::pretty },
+        { "compact", output_format::compact },
+        { "ndjson", output_format::ndjson },
+        { "cbor", output_format::cbor },
+        { "msgpack", output_format::msgpack }
+    };
+
+    const auto add_output_format_option = [&](CLI::App* cmd) {
+        cmd->add_option(
+            "--format", result.options.output_format,
+            "The output FORMAT. One of {pretty, compact, ndjson, cbor, msgpack}. The 'ndjson'"
+            " format writes one compact person object per line. The 'cbor' and 'msgpack' formats"
+            " are the binary encodings of the same JSON document. The default is 'pretty'.")
+            ->option_text("FORMAT")
+            ->default_val(output_format::pretty)
+            ->transform(CLI::CheckedTransformer(output_format_map, CLI::ignore_case));
+    };
+
+    const std::map<std::string, emit_format> emit_format_map {
+        { "make", emit_format::make },
+        { "ninja", emit_format::ninja }
+    };
+
+    const auto add_emit_format_option = [&](CLI::App* cmd) {
+        cmd->add_option(
+            "--emit", result.options.emit_format,
+            "The build file SYNTAX. One of {make, ninja}. The default is 'make'.")
+            ->option_text("SYNTAX")
+            ->default_val(emit_format::make)
+            ->transform(CLI::CheckedTransformer(emit_format_map, CLI::ignore_case));
+    };
+
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
 
     CLI::App* details_cmd = result.parser->add_subcommand(
-        "details", "Provide details of a single person");
+        "details",
+        "Provide details of a single person, or write the details files of many persons");
+
+    {
+        CLI::Option_group* selection_grp =
+            details_cmd->add_option_group("Selection", "The persons to provide details of");
+
+        selection_grp->add_option(
+            "-p,--person", result.options.details_cmd.person_uri,
+            "The Unique Resource Identifier (URI) of the person. The details are printed to the"
+            " standard output.")
+            ->option_text("URI");
+        CLI::Option* all_flag = selection_grp->add_flag(
+            "--all", result.options.details_cmd.all_flag,
+            "Write the details files of all the persons into the --tgt-root directory");
+        CLI::Option* list_opt = selection_grp->add_option(
+            "--person-list", result.options.details_cmd.person_list_path,
+            "Write the details files of the persons listed in the FILE (one URI per line) into the"
+            " --tgt-root directory")
+            ->option_text("FILE")
+            ->check(CLI::ExistingFile);
+        selection_grp->require_option(1);
+
+        CLI::Option* tgt_root_opt = details_cmd->add_option(
+            "--tgt-root", result.options.details_cmd.tgt_root_path,
+            "The PATH of the directory receiving the <unique_id>.json details files (it is"
+            " created if needed). The binary --format files have the .cbor or .msgpack extension.")
+            ->option_text("PATH");
+        all_flag->needs(tgt_root_opt);
+        list_opt->needs(tgt_root_opt);
+
+        details_cmd->add_option(
+            "--jobs", result.options.details_cmd.job_count,
+            "The number N of threads writing the details files concurrently. Every thread but the"
+            " first one queries its own copy of the model, so the run holds about N times the"
+            " memory of the loaded model. The value of 0 selects the number of hardware threads."
+            " The default is 1.")
+            ->option_text("N")
+            ->default_val(1)
+            ->check(CLI::NonNegativeNumber);
+    }
+
+    const std::map<std::string, query_backend> query_backend_map {
+        { "sparql", query_backend::sparql },
+        { "native", query_backend::native }
+    };
 
     details_cmd->add_option(
-        "-p,--person", result.options.details_cmd.person_uri,
-        "The Unique Resource Identifier (URI) of the person.")
-        ->option_text("URI")
-        ->required();
+        "--query-backend", result.options.details_cmd.query_backend,
+        "The implementation of the parent, partner, and child lookups. One of {sparql, native}."
+        " The 'native' backend looks the relatives up in the family graph index built once from"
+        " the model instead of running SPARQL queries. The default is 'sparql'.")
+        ->option_text("NAME")
+        ->default_val(query_backend::sparql)
+        ->transform(CLI::CheckedTransformer(query_backend_map, CLI::ignore_case));
+
+    details_cmd->add_option(
+        "--query-threads", result.options.details_cmd.query_thread_count,
+        "The number N of threads running the father, mother, partner, and child lookups of a"
+        " person concurrently (1 to 4). Every thread but the first one queries its own copy of"
+        " the model, made once per run, so each details job holds about N times the memory of"
+        " the loaded model. The copying pays off for the runs querying many persons (--all,"
+        " --person-list). The default is 1 (sequential lookups).")
+        ->option_text("N")
+        ->default_val(1)
+        ->check(CLI::Range(1, 4));
+
+    add_output_format_option(details_cmd);
 
-    result.parser->add_subcommand("list", "Provide the person list");
+    CLI::App* list_cmd = result.parser->add_subcommand("list", "Provide the person list");
+    add_output_format_option(list_cmd);
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
 
     {
         CLI::App* targets_cmd = result.parser->add_subcommand(
-            "targets", "Provide a list of output targets as a value of the make variable");
+            "targets",
+            "Provide a list of output targets as a value of the make variable, or as the ninja"
+            " build statements");
 
         CLI::Option* json_flag = targets_cmd->add_flag(
             "--json", result.options.targets_cmd.json_flag,
@@ -62,32 +198,132 @@ cli_context init_cli_context(spdlog::level::level_enum default_log_level)
             "The PATH that should prefix the resource specific target path (it doesn't have to exist)")
             ->option_text("PATH")
             ->required();
+
+        add_emit_format_option(targets_cmd);
+
+        CLI::Option* rule_opt = targets_cmd->add_option(
+            "--rule", result.options.targets_cmd.rule_name,
+            "The NAME of the ninja rule building the targets. The default is 'person_json' or"
+            " 'person_html' (depending on the target type).")
+            ->option_text("NAME");
+        CLI::Option* dyndep_opt = targets_cmd->add_option(
+            "--dyndep", result.options.targets_cmd.dyndep_path,
+            "The PATH of the ninja dyndep file (see the deps command) the build statements are"
+            " bound to. The build statement producing the file is printed as well.")
+            ->option_text("PATH");
+        CLI::Option* dyndep_rule_opt = targets_cmd->add_option(
+            "--dyndep-rule", result.options.targets_cmd.dyndep_rule_name,
+            "The NAME of the ninja rule producing the --dyndep file from the input data files"
+            " (e.g. running the deps command). The default is 'person_deps'.")
+            ->option_text("NAME")
+            ->default_val("person_deps")
+            ->needs(dyndep_opt);
+        CLI::Option* meta_target_opt = targets_cmd->add_option(
+            "--meta-target", result.options.targets_cmd.meta_target,
+            "The NAME of the ninja phony target aggregating all the targets.")
+            ->option_text("NAME");
+
+        // The make variable has no place for the build statement settings
+        targets_cmd->callback(
+            [&options = result.options, rule_opt, dyndep_opt, dyndep_rule_opt, meta_target_opt]() {
+                if (options.emit_format == emit_format::ninja)
+                {
+                    return;
+                }
+
+                for (const CLI::Option* opt :
+                         { rule_opt, dyndep_opt, dyndep_rule_opt, meta_target_opt })
+                {
+                    if (opt->count() > 0)
+                    {
+                        throw CLI::ValidationError(
+                            opt->get_name(), "The option requires the '--emit ninja' option");
+                    }
+                }
+            });
     }
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
 
     CLI::App* deps_cmd = result.parser->add_subcommand(
-        "deps", "Provide dependencies of a single person details file in the make file format");
+        "deps",
+        "Provide dependencies of a single person details file, or of all of them, in the make"
+        " file or the ninja dyndep file format");
 
     deps_cmd->add_option(
         "--tgt-root", result.options.deps_cmd.tgt_root_path,
-        "The PATH that will prefix the intermediate (json) target paths in the generated"
-        " dependencies")
+        "The PATH that will prefix the target paths in the generated dependencies (the json"
+        " intermediate targets unless the --html option is specified)")
         ->option_text("PATH")
         ->required();
 
     deps_cmd->add_option(
         "--meta-target", result.options.deps_cmd.meta_target,
         fmt::format(
-            "The NAME of the meta target aggregating the generated intermediate file targets."))
+            "The NAME of the meta target aggregating the generated intermediate file targets."
+            " The ninja dyndep file has no such target (see the targets --meta-target option)."))
         ->required()
         ->option_text("NAME");
 
+    {
+        CLI::Option_group* selection_grp =
+            deps_cmd->add_option_group("Selection", "The persons to provide dependencies of");
+
+        selection_grp->add_option(
+            "-p,--person", result.options.deps_cmd.person_uri,
+            "The Unique Resource Identifier (URI) of the person.")
+            ->option_text("URI");
+        selection_grp->add_flag(
+            "--all", result.options.deps_cmd.all_flag,
+            "Provide the dependencies of all the persons (the dependencies are computed once)");
+        selection_grp->require_option(1);
+    }
+
+    {
+        CLI::Option* json_flag = deps_cmd->add_flag(
+            "--json", result.options.deps_cmd.json_flag,
+            "Provide the dependencies of the JSON targets (the default)");
+        deps_cmd->add_flag(
+            "--html", result.options.deps_cmd.html_flag,
+            "Provide the dependencies of the HTML targets (see the targets command)")
+            ->excludes(json_flag);
+    }
+
+    deps_cmd->add_option(
+        "-o,--out", result.options.deps_cmd.output_path,
+        "The PATH of the make (or ninja dyndep) file receiving the dependencies. The dependencies"
+        " are printed to the standard output by default.")
+        ->option_text("PATH");
+
+    add_emit_format_option(deps_cmd);
+
+    // Every build statement bound to the ninja dyndep file has to be listed in the file
+    deps_cmd->callback([&options = result.options]() {
+        if ((options.emit_format == emit_format::ninja) && !options.deps_cmd.all_flag)
+        {
+            throw CLI::ValidationError(
+                "--emit", "The ninja dyndep file requires the '--all' option");
+        }
+    });
+
     deps_cmd->add_option(
-        "-p,--person", result.options.deps_cmd.person_uri,
-        "The Unique Resource Identifier (URI) of the person.")
-        ->option_text("URI")
+        "--deps-cache", result.options.deps_cmd.deps_cache_path,
+        "The PATH of the file caching the dependency facts of every input file. Only the input"
+        " files changed since the previous run are parsed and the model isn't loaded at all. The"
+        " option is ignored when the --snapshot option is specified.")
+        ->option_text("PATH");
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+    CLI::App* snapshot_cmd = result.parser->add_subcommand(
+        "snapshot", "Save the input turtle files as a binary model snapshot");
+
+    snapshot_cmd->add_option(
+        "-o,--out", result.options.snapshot_cmd.output_path,
+        "The PATH of the model snapshot file to be created (an existing file is replaced)")
+        ->option_text("PATH")
         ->required();
+
     return result;
 }
 
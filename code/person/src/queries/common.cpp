@@ -1,8 +1,16 @@
 #include "person/queries/common.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <utility>
+
 #include <fmt/format.h>
 
+#include "common/query_template.hpp"
 #include "person/error.hpp"
+#include "person/family_graph.hpp"
+#include "person/queries/identity_map.hpp"
 
 namespace person
 {
@@ -12,19 +20,17 @@ std::shared_ptr<common::Person> retrieve_person_caption_data_opt(
 {
     spdlog::trace("{}: Entry checkpoint ({})", __func__, person_uri);
 
-    const std::string query = R"(
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
 
         SELECT ?person
         WHERE {
             ?person a gx:Person .
-            FILTER (?person = <)" + person_uri + R"(>)
-        })";
-
-    spdlog::debug("{}: The query: {}", __func__, query);
+            FILTER (?person = %{person})
+        })");
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
+    const common::extract_data_table_result data_tuple =
+        common::exec_templated_query(world, model, query, {{ "person", person_uri }});
     const common::data_table& data_table = std::get<1>(data_tuple);
 
     if (data_table.empty())
@@ -93,7 +99,7 @@ std::shared_ptr<common::Person> retrieve_person_base_data_opt(
 
     spdlog::trace("{}: Entry checkpoint ({})", __func__, person_uri);
 
-    const std::string query = R"(
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
 
         SELECT ?person, ?genderType, ?birthDate, ?deathDate
@@ -110,13 +116,11 @@ std::shared_ptr<common::Person> retrieve_person_base_data_opt(
             OPTIONAL {
                 ?person gx:deathDate ?deathDate
             }
-            FILTER (?person = <)" + person_uri + R"(>)
-        })";
-
-    spdlog::debug("{}: The query: {}", __func__, query);
+            FILTER (?person = %{person})
+        })");
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
+    const common::extract_data_table_result data_tuple =
+        common::exec_templated_query(world, model, query, {{ "person", person_uri }});
     const common::data_table& data_table = std::get<1>(data_tuple);
 
     if (data_table.empty()) {
@@ -161,137 +165,138 @@ std::shared_ptr<common::Person> retrieve_person_base_data_req(
 retrieve_result retrieve_person_name(
     common::Person& person, librdf_world* world, librdf_model* model)
 {
+    spdlog::trace("{}: Entry checkpoint ({})", __func__, person.get_uri_str());
 
-    spdlog::debug("{}: Attempting to retrieve the preferred name", __func__);
-
-    retrieve_result preferred_res =
-        retrieve_person_preferred_name(person, world, model);
-
-    spdlog::debug(
-        "{}: The result code of the retrieve_person_preferred_name function is: {}",
-        __func__, preferred_res);
-
-    if (preferred_res == retrieve_result::Success) {
-        spdlog::debug("{}: Preferred name retrieved", __func__);
-
-        return retrieve_result::Success;
-    }
-
-    spdlog::debug("{}: Attempting to retrieve the birth name", __func__);
-
-    retrieve_result birth_res =
-        retrieve_person_birth_name(person, world, model);
-
-    spdlog::debug(
-        "{}: The result code of the retrieve_person_birth_name function is: {}",
-        __func__, birth_res);
-
-    if (birth_res == retrieve_result::Success) {
-        spdlog::debug("{}: Birth name retrieved", __func__);
-
-        return retrieve_result::Success;
-    }
-
-    spdlog::debug("{}: Attempting to retrieve any name", __func__);
-
-    retrieve_result any_res =
-        retrieve_person_any_name(person, world, model);
-
-    spdlog::debug(
-        "{}: The result code of the retrieve_person_any_name function is: {}", __func__, any_res);
-
-    if (any_res == retrieve_result::Success) {
-        spdlog::debug("{}: Some name retrieved", __func__);
-
-        return retrieve_result::Success;
-    }
-
-    return retrieve_result::NotFound;
-}
-
-
-retrieve_result retrieve_person_any_name(
-    common::Person& person, librdf_world* world, librdf_model* model)
-{
-    const std::string query = R"(
+    /* All the candidate names are retrieved at once and the winner is selected by the
+     * select_person_name_rows function (the same precedence as in the retrieve_person_list) */
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
+        PREFIX xsd: <http://www.w3.org/2001/XMLSchema#>
 
         SELECT
-            ?nameType, ?nameValue
+            ?name, ?preferred, ?birthName, ?nameType, ?nameValue
         WHERE
         {
-            {
-                SELECT ?name
-                WHERE
-                {
-                    ?person a gx:Person ;
-                        gx:name ?name .
-                    FILTER (?person = <)" + person.get_uri_str() + R"(>)
-                }
-                LIMIT 1
-            }
+            ?person a gx:Person ;
+                gx:name ?name .
             ?name gx:nameForm ?form .
             ?form gx:part ?part .
             ?part gx:type ?nameType ;
                 gx:value ?nameValue .
-        })";
+            OPTIONAL {
+                ?name gx:preferred ?preferred .
+                FILTER (sameTerm(?preferred, "true"^^xsd:boolean))
+            }
+            OPTIONAL {
+                ?name gx:type ?birthName .
+                FILTER (?birthName = gx:BirthName)
+            }
+            FILTER (?person = %{person})
+        })");
 
-    spdlog::debug("retrieve_person_any_name: The query: {}", query);
+    const common::extract_data_table_result data_tuple =
+        common::exec_templated_query(world, model, query, {{ "person", person.get_uri_str() }});
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+    const common::data_table name_rows = select_person_name_rows(std::get<1>(data_tuple));
 
-    if (data_table.empty()) {
+    if (name_rows.empty())
+    {
         spdlog::debug(
-            "retrieve_person_any_name: Properly formed names of person {} were not found",
+            "{}: Properly formed names of person {} were not found", __func__,
             person.get_uri_str());
 
         return retrieve_result::NotFound;
     }
 
-    extract_person_names(person, data_table);
+    extract_person_names(person, name_rows);
 
     return retrieve_result::Success;
 }
 
 
-retrieve_result retrieve_person_birth_name(
-    common::Person& person, librdf_world* world, librdf_model* model)
+common::data_table select_person_name_rows(const common::data_table& name_table)
+{
+    const auto select_rows = [&name_table](auto&& pred) {
+        common::data_table result;
+
+        std::copy_if(
+            name_table.begin(), name_table.end(), std::back_inserter(result), pred);
+
+        return result;
+    };
+
+    common::data_table result = select_rows(
+        [](const common::data_row& row) { return common::has_binding(row, "preferred"); });
+
+    if (result.empty())
+    {
+        result = select_rows(
+            [](const common::data_row& row) { return common::has_binding(row, "birthName"); });
+    }
+
+    if (result.empty() && !name_table.empty())
+    {
+        const std::string& first_name = common::get_binding_value_req(
+            name_table.front(), "name")->second; // throws common_exception
+
+        result = select_rows(
+            [&first_name](const common::data_row& row) {
+                return (common::get_binding_value_req(row, "name")->second == first_name);
+            });
+    }
+
+    return result;
+}
+
+
+std::unordered_map<std::string, common::data_table> retrieve_person_name_tables(
+    librdf_world* world, librdf_model* model)
 {
-    const std::string query = R"(
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
+        PREFIX xsd: <http://www.w3.org/2001/XMLSchema#>
 
         SELECT
-            ?nameType, ?nameValue
+            ?person, ?name, ?preferred, ?birthName, ?nameType, ?nameValue
         WHERE
         {
             ?person a gx:Person ;
                 gx:name ?name .
-            ?name gx:type gx:BirthName ;
-                gx:nameForm ?form .
+            ?name gx:nameForm ?form .
             ?form gx:part ?part .
             ?part gx:type ?nameType ;
                 gx:value ?nameValue .
-            FILTER (?person = <)" + person.get_uri_str() + R"(>)
-        })";
-
-    spdlog::debug("retrieve_person_birth_name: The query: {}", query);
+            OPTIONAL {
+                ?name gx:preferred ?preferred .
+                FILTER (sameTerm(?preferred, "true"^^xsd:boolean))
+            }
+            OPTIONAL {
+                ?name gx:type ?birthName .
+                FILTER (?birthName = gx:BirthName)
+            }
+        })");
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
+    const common::extract_data_table_result data_tuple =
+        common::exec_templated_query(world, model, query);
     const common::data_table& data_table = std::get<1>(data_tuple);
 
-    if (data_table.empty()) {
-        spdlog::debug(
-            "retrieve_person_birth_name: Properly formed birth names of person {} were not found",
-            person.get_uri_str());
-        return retrieve_result::NotFound;
+    std::unordered_map<std::string, common::data_table> result;
+
+    for (const common::data_row& row : data_table)
+    {
+        const std::string& person_uri =
+            common::get_binding_value_req(row, "person")->second; // throws common_exception
+
+        result[person_uri].push_back(row);
     }
 
-    extract_person_names(person, data_table);
+    spdlog::debug(
+        "{}: Retrieved {} name part rows of {} persons", __func__, data_table.size(),
+        result.size());
 
-    return retrieve_result::Success;
+    return result;
 }
 
 
@@ -299,19 +304,17 @@ common::resource_set retrieve_person_uris(librdf_world* world, librdf_model* mod
 {
     spdlog::trace("{}: Entry checkpoint", __func__);
 
-    const std::string query = R"(
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
 
         SELECT DISTINCT ?person
         WHERE {
             ?person a gx:Person .
         }
-        ORDER BY ASC(?person))";
+        ORDER BY ASC(?person))");
 
-    spdlog::debug("{}: The query: {}", __func__, query);
-
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
+    const common::extract_data_table_result data_tuple =
+        common::exec_templated_query(world, model, query);
     const common::data_table& data_table = std::get<1>(data_tuple);
 
     common::resource_set result;
@@ -325,97 +328,108 @@ common::resource_set retrieve_person_uris(librdf_world* world, librdf_model* mod
 }
 
 
-retrieve_result retrieve_person_preferred_name(
-    common::Person& person, librdf_world* world, librdf_model* model)
+retrieve_result retrieve_person_children(
+    common::Person& person, librdf_world* world, librdf_model* model, query_backend backend,
+    person_identity_map* identity_map, const family_graph* graph)
 {
-    const std::string query = R"(
-        PREFIX gx: <http://gedcomx.org/>
-        PREFIX xsd: <http://www.w3.org/2001/XMLSchema#>
+    person_identity_map local_identity_map(world, model);
+    person_identity_map& persons = (identity_map ? *identity_map : local_identity_map);
 
-        SELECT
-            ?nameType, ?nameValue
-        WHERE
+    // The child uri and the optional other parent uri pairs
+    std::vector<std::pair<std::string, std::optional<std::string>>> child_seq;
+
+    if (backend == query_backend::native)
+    {
+        std::optional<family_graph> local_graph;
+        const family_graph& family =
+            (graph ? *graph : local_graph.emplace(build_family_graph(world, model)));
+        const std::optional<person_id> proband_id = family.find_node(person.get_uri_str());
+        const std::span<const family_edge> children =
+            (proband_id ? family.get_children(*proband_id) : std::span<const family_edge>());
+
+        for (const family_edge& child : children)
         {
-            ?person a gx:Person ;
-                gx:name ?name .
-            ?name gx:preferred "true"^^xsd:boolean ;
-                gx:nameForm ?form .
-            ?form gx:part ?part .
-            ?part gx:type ?nameType ;
-                gx:value ?nameValue .
-            FILTER (?person = <)" + person.get_uri_str() + R"(>)
-        })";
+            if (!family.is_person(child.target))
+            {
+                continue;
+            }
 
-    spdlog::debug("retrieve_person_preferred_name: The query: {}", query);
+            const std::string& child_uri = family.get_uri(child.target);
+            bool partner_found = false;
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+            for (const family_edge& partner : family.get_parents(child.target))
+            {
+                if (partner.target != *proband_id)
+                {
+                    child_seq.emplace_back(child_uri, family.get_uri(partner.target));
+                    partner_found = true;
+                }
+            }
 
-    if (data_table.empty()) {
-        spdlog::debug(
-            "retrieve_person_preferred_name: Properly formed preferred names of person {} were not"
-            " found", person.get_uri_str());
-        return retrieve_result::NotFound;
+            if (!partner_found)
+            {
+                child_seq.emplace_back(child_uri, std::nullopt);
+            }
+        }
     }
+    else
+    {
+        static const common::query_template query(__func__, R"(
+            PREFIX gx: <http://gedcomx.org/>
 
-    extract_person_names(person, data_table);
-
-    return retrieve_result::Success;
-}
-
+            SELECT
+                ?child ?partner
+            WHERE
+            {
+                ?rel1 a gx:Relationship ;
+                    gx:person1 ?proband ;
+                    gx:person2 ?child ;
+                    gx:type gx:ParentChild .
+                OPTIONAL {
+                    ?rel2 a gx:Relationship ;
+                        gx:person1 ?partner ;
+                        gx:person2 ?child ;
+                        gx:type gx:ParentChild .
+                    FILTER(?partner != ?proband)
+                }
+                ?child a gx:Person .
+                FILTER (?proband = %{person})
+            })");
 
-retrieve_result retrieve_person_children(
-    common::Person& person, librdf_world* world, librdf_model* model)
-{
-    const std::string query = R"(
-        PREFIX gx: <http://gedcomx.org/>
+        const common::column_table table = common::exec_templated_column_query(
+            world, model, query, {{ "person", person.get_uri_str() }});
 
-        SELECT
-            ?child ?partner
-        WHERE
+        if (!table.empty())
         {
-            ?rel1 a gx:Relationship ;
-                gx:person1 ?proband ;
-                gx:person2 ?child ;
-                gx:type gx:ParentChild .
-            OPTIONAL {
-                ?rel2 a gx:Relationship ;
-                    gx:person1 ?partner ;
-                    gx:person2 ?child ;
-                    gx:type gx:ParentChild .
-                FILTER(?partner != ?proband)
-            }
-            ?child a gx:Person .
-            FILTER (?proband = <)" + person.get_uri_str() + R"(>)
-        })";
+            const auto child_col = table.get_column_req("child");
+            const auto partner_col = table.get_column_req("partner");
 
-    spdlog::debug("{}: The query: {}", __func__, query);
+            for (std::size_t row = 0; row < table.get_row_count(); ++row)
+            {
+                const std::optional<std::string_view> partner = table.get(row, partner_col);
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+                child_seq.emplace_back(
+                    std::string(table.get_req(row, child_col)),
+                    (partner ? std::optional<std::string>(*partner) : std::nullopt));
+            }
+        }
+    }
 
-    if (data_table.empty()) {
+    if (child_seq.empty()) {
         spdlog::debug(
             "{}: No children of person {} were found", __func__, person.get_uri_str());
 
         return retrieve_result::NotFound;
     }
 
-    for (const common::data_row& row : data_table) {
-        auto uri_it = common::get_binding_value_req(row, "child");
-
+    for (const auto& [child_uri, partner_uri] : child_seq) {
         /* Exceptional path (resource not found): Propagate the exception
          * Normal path (resource found): Continue the execution */
-        auto child = retrieve_person_base_data_req(uri_it->second, world, model);
-
-        retrieve_person_name(*child, world, model);
+        auto child = persons.get_base_data_req(child_uri);
 
-        if (common::has_binding(row, "partner"))
+        if (partner_uri)
         {
-            auto partner = common::extract_resource<common::Resource>(row, "partner");
-            person.children[*partner].push_back(child);
+            person.children[common::Resource(*partner_uri)].push_back(child);
         }
         else
         {
@@ -427,12 +441,12 @@ retrieve_result retrieve_person_children(
 }
 
 
-std::vector<std::shared_ptr<common::Person>> retrieve_person_list(
-    librdf_world* world, librdf_model* model)
+std::size_t visit_person_list(
+    librdf_world* world, librdf_model* model, const person_list_visitor& visitor)
 {
     spdlog::trace("{}: Entry checkpoint", __func__);
 
-    const std::string query = R"(
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
 
         SELECT ?person, ?genderType, ?birthDate, ?deathDate
@@ -449,28 +463,45 @@ std::vector<std::shared_ptr<common::Person>> retrieve_person_list(
             OPTIONAL {
                 ?person gx:deathDate ?deathDate
             }
-        })";
+        })");
 
-    spdlog::debug("{}: The query: {}", __func__, query);
+    /* Resolve the names of all the listed persons up front instead of issuing up to three name
+     * queries per person */
+    const std::unordered_map<std::string, common::data_table> name_tables =
+        retrieve_person_name_tables(world, model);
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+    // The list query result is streamed, so the result table of the whole data set is never held
+    //  in memory
+    return common::visit_templated_query(
+        world, model, query, {},
+        [&](const common::query_row_view& row) {
+            common::Person person(std::string(row.get_req("person"))); // throws common_exception
 
-    std::vector<std::shared_ptr<common::Person>> result;
-    result.reserve(data_table.size());
+            person.gender = common::extract_person_gender(row, "genderType", person.notes());
+            common::extract_person_birth_date(person, row, "birthDate");
+            common::extract_person_death_date(person, row, "deathDate");
 
-    for (const common::data_row& row : data_table)
-    {
-        auto person = common::extract_resource<common::Person>(row, "person");
+            const auto name_it = name_tables.find(person.get_uri_str());
+
+            if (name_it != name_tables.end())
+            {
+                extract_person_names(person, select_person_name_rows(name_it->second));
+            }
 
-        person->gender = extract_person_gender(row, "genderType", person->notes());
-        extract_person_birth_date(*person, row, "birthDate");
-        extract_person_death_date(*person, row, "deathDate");
-        retrieve_person_name(*person, world, model);
+            visitor(person);
+        });
+}
 
-        result.emplace_back(person);
-    }
+std::vector<std::shared_ptr<common::Person>> retrieve_person_list(
+    librdf_world* world, librdf_model* model)
+{
+    std::vector<std::shared_ptr<common::Person>> result;
+
+    visit_person_list(
+        world, model,
+        [&result](const common::Person& person) {
+            result.emplace_back(std::make_shared<common::Person>(person));
+        });
 
     return result;
 }
@@ -2,13 +2,14 @@
 
 #include <spdlog/spdlog.h>
 
+#include "common/query_template.hpp"
 #include "person/error.hpp"
 
 namespace person
 {
 
 /**
- * Retrieve all distinct pairs of gx:Person resources that are related.
+ * Stream all distinct pairs of gx:Person resources that are related to the visitor.
  *
  * A pair (x,y) is returned if and only if:
  *  - x and y appear together in the same gx:Relationship resource (any subtype), or
@@ -19,13 +20,14 @@ namespace person
  *  - Each unordered pair is returned exactly once.
  *  - Self-pairs are excluded (x ≠ y).
  *
- * @return Sequence of unique, canonicalized person pairs (a,b).
+ * @return the number of the visited pairs
  */
-common::data_table retrieve_related_persons(librdf_world* world, librdf_model* model)
+std::size_t visit_related_persons(
+    librdf_world* world, librdf_model* model, const related_persons_visitor& visitor)
 {
     spdlog::trace("{}: Entry checkpoint", __func__);
 
-    const std::string query = R"(
+    static const common::query_template query(__func__, R"(
         PREFIX gx: <http://gedcomx.org/>
 
         SELECT DISTINCT ?person1 ?person2
@@ -55,14 +57,35 @@ common::data_table retrieve_related_persons(librdf_world* world, librdf_model* m
             FILTER (!sameTerm(?candidate1, ?candidate2))
             BIND(IF(STR(?candidate1) < STR(?candidate2), ?candidate1, ?candidate2) AS ?person1)
             BIND(IF(STR(?candidate1) < STR(?candidate2), ?candidate2, ?candidate1) AS ?person2)
-        })";
+        })");
 
-    spdlog::debug("{}: The query: {}", __func__, query);
-
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
+    return common::visit_templated_query(
+        world, model, query, {},
+        [&visitor](const common::query_row_view& row) {
+            visitor(row.get_req("person1"), row.get_req("person2")); // throws common_exception
+        });
+}
 
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    return std::get<1>(data_tuple);
+/**
+ * Retrieve all distinct pairs of gx:Person resources that are related.
+ *
+ * The materialized counterpart of the visit_related_persons function. Each row of the result
+ *  table has the "person1" and the "person2" bindings.
+ */
+common::data_table retrieve_related_persons(librdf_world* world, librdf_model* model)
+{
+    common::data_table result;
+
+    visit_related_persons(
+        world, model,
+        [&result](std::string_view person1, std::string_view person2) {
+            result.push_back({
+                    { "person1", std::string(person1) },
+                    { "person2", std::string(person2) }
+                });
+        });
+
+    return result;
 }
 
 bool ask_resource_referenced(
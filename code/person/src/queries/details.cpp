@@ -1,10 +1,21 @@
 #include "person/queries/details.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <optional>
 #include <ranges>
+#include <string>
+#include <thread>
+#include <utility>
 
 #include <fmt/format.h>
 
-#include "common/data_table.hpp"
+#include "common/column_table.hpp"
+#include "common/query_template.hpp"
 #include "common/resource_utils.hpp"
 #include "common/string.hpp"
 #include "common/spdlog_utils.hpp"
@@ -66,11 +77,67 @@ common::Note create_multiple_mothers_note(
             common::join(common::extract_uri_str_seq(mothers), "\n    ")));
 }
 
+/** @brief Find the parents of the proband being persons of the given gender in the family graph
+ *
+ *  The parent uris are sorted (the graph node order) to make the multiple parents note
+ *   independent of the storage statement order. */
+std::vector<std::string> find_parent_uri_seq_native(
+    const family_graph& graph, const std::string& proband_uri,
+    bool (family_graph::*has_gender)(person_id) const)
+{
+    std::vector<std::string> result;
+    const std::optional<person_id> proband_id = graph.find_node(proband_uri);
+
+    if (!proband_id)
+    {
+        return result;
+    }
+
+    for (const family_edge& parent : graph.get_parents(*proband_id))
+    {
+        if (graph.is_person(parent.target) && (graph.*has_gender)(parent.target))
+        {
+            result.push_back(graph.get_uri(parent.target));
+        }
+    }
+
+    return result;
+}
+
+/** @brief Find the partners of the proband in the family graph
+ *
+ *  @return the partner uris sorted ascending and mapped to the inferred flag (a partner is
+ *      inferred if it isn't a stated partner of any gx:Couple relationship) */
+std::map<std::string, bool> find_partner_uris_native(
+    const family_graph& graph, const std::string& proband_uri)
+{
+    std::map<std::string, bool> result;
+    const std::optional<person_id> proband_id = graph.find_node(proband_uri);
+
+    if (!proband_id)
+    {
+        return result;
+    }
+
+    for (const person_id partner : graph.get_inferred_partners(*proband_id))
+    {
+        result.emplace(graph.get_uri(partner), true);
+    }
+
+    for (const person_id partner : graph.get_partners(*proband_id))
+    {
+        result.insert_or_assign(graph.get_uri(partner), false);
+    }
+
+    return result;
+}
+
 } // anonymous namespace
 
 std::shared_ptr<common::Person> retrieve_person_father(
     const common::Person* proband, librdf_world* world, librdf_model* model,
-    std::vector<common::Note>& notes)
+    std::vector<common::Note>& notes, query_backend backend,
+    person_identity_map* identity_map, const family_graph* graph)
 {
     if (!proband)
     {
@@ -96,63 +163,70 @@ std::shared_ptr<common::Person> retrieve_person_father(
                 "Precondition failure: model={} must satisfy !nullptr", fmt::ptr(model)));
     }
 
-    const std::string query = R"(
-        PREFIX gx: <http://gedcomx.org/>
+    person_identity_map local_identity_map(world, model);
+    person_identity_map& persons = (identity_map ? *identity_map : local_identity_map);
 
-        SELECT
-            ?father
-        WHERE
-        {
-            ?rel a gx:Relationship ;
-                gx:person1 ?father ;
-                gx:person2 ?proband ;
-                gx:type gx:ParentChild .
-            ?father a gx:Person ;
-                gx:gender ?gender .
-            ?gender a gx:Gender ;
-                gx:type gx:Male .
-            FILTER (?proband = <)" + proband->get_uri_str() + R"(>)
-        })";
+    std::vector<std::string> father_uri_seq;
 
-    const char* query_id = "retrieve proband father";
+    if (backend == query_backend::native)
+    {
+        std::optional<family_graph> local_graph;
 
-    spdlog::debug("{}: The '{}' query: {}", __func__, query_id, query);
+        father_uri_seq = find_parent_uri_seq_native(
+            (graph ? *graph : local_graph.emplace(build_family_graph(world, model))),
+            proband->get_uri_str(), &family_graph::is_male);
+    }
+    else
+    {
+        static const common::query_template query(__func__, R"(
+            PREFIX gx: <http://gedcomx.org/>
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+            SELECT
+                ?father
+            WHERE
+            {
+                ?rel a gx:Relationship ;
+                    gx:person1 ?father ;
+                    gx:person2 ?proband ;
+                    gx:type gx:ParentChild .
+                ?father a gx:Person ;
+                    gx:gender ?gender .
+                ?gender a gx:Gender ;
+                    gx:type gx:Male .
+                FILTER (?proband = %{proband})
+            })");
+
+        const common::column_table table = common::exec_templated_column_query(
+            world, model, query, {{ "proband", proband->get_uri_str() }});
+
+        father_uri_seq = common::extract_resource_uri_seq(table, "father");
+    }
 
-    if (data_table.empty())
+    if (father_uri_seq.empty())
     {
         spdlog::debug("{}: Father of proband {} wasn't found", __func__, proband->get_uri_str());
         return {};
     }
-    else if (data_table.size() > 1)
+    else if (father_uri_seq.size() > 1)
     {
         spdlog::debug(
             "{}: Multiple ({}) fathers of proband {} were found",
-            __func__, data_table.size(), proband->get_uri_str());
+            __func__, father_uri_seq.size(), proband->get_uri_str());
 
         notes.emplace_back(
             create_multiple_fathers_note(
-                retrieve_person_caption_data_seq_req(
-                    common::extract_resource_uri_seq(data_table, "father"),
-                    world, model)));
+                persons.get_caption_data_seq_req(father_uri_seq)));
 
         return {};
     }
 
-    const auto& row = data_table.front();
-    const auto& uri_it = common::get_binding_value_req(row, "father");
-    auto parent = retrieve_person_base_data_req(uri_it->second, world, model);
-    retrieve_person_name(*parent, world, model);
-
-    return parent;
+    return persons.get_base_data_req(father_uri_seq.front());
 }
 
 std::shared_ptr<common::Person> retrieve_person_mother(
     const common::Person* proband, librdf_world* world, librdf_model* model,
-    std::vector<common::Note>& notes)
+    std::vector<common::Note>& notes, query_backend backend,
+    person_identity_map* identity_map, const family_graph* graph)
 {
     if (!proband)
     {
@@ -178,64 +252,71 @@ std::shared_ptr<common::Person> retrieve_person_mother(
                 "Precondition failure: model={} must satisfy !nullptr", fmt::ptr(model)));
     }
 
-    const std::string query = R"(
-        PREFIX gx: <http://gedcomx.org/>
+    person_identity_map local_identity_map(world, model);
+    person_identity_map& persons = (identity_map ? *identity_map : local_identity_map);
 
-        SELECT
-            ?mother
-        WHERE
-        {
-            ?rel a gx:Relationship ;
-                gx:person1 ?mother ;
-                gx:person2 ?proband ;
-                gx:type gx:ParentChild .
-            ?mother a gx:Person ;
-                gx:gender ?gender .
-            ?gender a gx:Gender ;
-                gx:type gx:Female .
-            FILTER (?proband = <)" + proband->get_uri_str() + R"(>)
-        })";
+    std::vector<std::string> mother_uri_seq;
 
-    const char* query_id = "retrieve proband mother";
+    if (backend == query_backend::native)
+    {
+        std::optional<family_graph> local_graph;
 
-    spdlog::debug("{}: The '{}' query: {}", __func__, query_id, query);
+        mother_uri_seq = find_parent_uri_seq_native(
+            (graph ? *graph : local_graph.emplace(build_family_graph(world, model))),
+            proband->get_uri_str(), &family_graph::is_female);
+    }
+    else
+    {
+        static const common::query_template query(__func__, R"(
+            PREFIX gx: <http://gedcomx.org/>
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+            SELECT
+                ?mother
+            WHERE
+            {
+                ?rel a gx:Relationship ;
+                    gx:person1 ?mother ;
+                    gx:person2 ?proband ;
+                    gx:type gx:ParentChild .
+                ?mother a gx:Person ;
+                    gx:gender ?gender .
+                ?gender a gx:Gender ;
+                    gx:type gx:Female .
+                FILTER (?proband = %{proband})
+            })");
+
+        const common::column_table table = common::exec_templated_column_query(
+            world, model, query, {{ "proband", proband->get_uri_str() }});
+
+        mother_uri_seq = common::extract_resource_uri_seq(table, "mother");
+    }
 
-    if (data_table.empty())
+    if (mother_uri_seq.empty())
     {
         spdlog::debug("{}: Mother of proband {} wasn't found", __func__, proband->get_uri_str());
 
         return {};
     }
-    else if (data_table.size() > 1)
+    else if (mother_uri_seq.size() > 1)
     {
         spdlog::debug(
             "{}: Multiple ({}) mothers of proband {} were found",
-            __func__, data_table.size(), proband->get_uri_str());
+            __func__, mother_uri_seq.size(), proband->get_uri_str());
 
         notes.emplace_back(
             create_multiple_mothers_note(
-                retrieve_person_caption_data_seq_req(
-                    common::extract_resource_uri_seq(data_table, "mother"),
-                    world, model)));
+                persons.get_caption_data_seq_req(mother_uri_seq)));
 
         return {};
     }
 
-    const auto& row = data_table.front();
-    const auto& uri_it = common::get_binding_value_req(row, "mother");
-    auto parent = retrieve_person_base_data_req(uri_it->second, world, model);
-    retrieve_person_name(*parent, world, model);
-
-    return parent;
+    return persons.get_base_data_req(mother_uri_seq.front());
 }
 
 std::vector<common::Person::PartnerRelation> retrieve_person_partners(
     const common::Person* proband, librdf_world* world, librdf_model* model,
-    std::vector<common::Note>& notes)
+    std::vector<common::Note>& notes, query_backend backend,
+    person_identity_map* identity_map, const family_graph* graph)
 {
     if (!proband)
     {
@@ -261,66 +342,106 @@ std::vector<common::Person::PartnerRelation> retrieve_person_partners(
                 "Precondition failure: model={} must satisfy !nullptr", fmt::ptr(model)));
     }
 
-    const std::string query = R"(
-        PREFIX gx: <http://gedcomx.org/>
+    person_identity_map local_identity_map(world, model);
+    person_identity_map& persons = (identity_map ? *identity_map : local_identity_map);
+
+    // The partner uri and the inferred flag pairs
+    std::vector<std::pair<std::string, bool>> partner_seq;
+
+    if (backend == query_backend::native)
+    {
+        std::optional<family_graph> local_graph;
+        const family_graph& family =
+            (graph ? *graph : local_graph.emplace(build_family_graph(world, model)));
 
-        SELECT DISTINCT ?partner, (MIN(?inferred_int) AS ?inferred)
-        WHERE
+        for (const auto& [partner_uri, inferred] :
+                 find_partner_uris_native(family, proband->get_uri_str()))
         {
+            partner_seq.emplace_back(partner_uri, inferred);
+        }
+    }
+    else
+    {
+        static const common::query_template query(__func__, R"(
+            PREFIX gx: <http://gedcomx.org/>
+
+            SELECT DISTINCT ?partner, (MIN(?inferred_int) AS ?inferred)
+            WHERE
             {
                 {
-                    SELECT DISTINCT ?partner
-                    WHERE
                     {
-                        ?rel1 a gx:Relationship ;
-                            gx:person1 ?proband ;
-                            gx:person2 ?child ;
-                            gx:type gx:ParentChild .
-                        ?rel2 a gx:Relationship ;
-                            gx:person1 ?partner ;
-                            gx:person2 ?child ;
-                            gx:type gx:ParentChild .
-                        FILTER ((?partner != ?proband) &&
-                                (?proband = <)" + proband->get_uri_str() + R"(>))
+                        SELECT DISTINCT ?partner
+                        WHERE
+                        {
+                            ?rel1 a gx:Relationship ;
+                                gx:person1 ?proband ;
+                                gx:person2 ?child ;
+                                gx:type gx:ParentChild .
+                            ?rel2 a gx:Relationship ;
+                                gx:person1 ?partner ;
+                                gx:person2 ?child ;
+                                gx:type gx:ParentChild .
+                            FILTER ((?partner != ?proband) &&
+                                    (?proband = %{proband}))
+                        }
                     }
+                    BIND(true AS ?inferred_int)
                 }
-                BIND(true AS ?inferred_int)
-            }
-            UNION
-            {
+                UNION
                 {
-                    SELECT DISTINCT ?partner
-                    WHERE
                     {
+                        SELECT DISTINCT ?partner
+                        WHERE
                         {
-                            ?rel a gx:Relationship ;
-                                gx:person1 ?partner ;
-                                gx:person2 ?proband ;
-                                gx:type gx:Couple .
-                        }
-                        UNION
-                        {
-                            ?rel a gx:Relationship ;
-                                gx:person1 ?proband ;
-                                gx:person2 ?partner ;
-                                gx:type gx:Couple .
+                            {
+                                ?rel a gx:Relationship ;
+                                    gx:person1 ?partner ;
+                                    gx:person2 ?proband ;
+                                    gx:type gx:Couple .
+                            }
+                            UNION
+                            {
+                                ?rel a gx:Relationship ;
+                                    gx:person1 ?proband ;
+                                    gx:person2 ?partner ;
+                                    gx:type gx:Couple .
+                            }
+                            FILTER ((?partner != ?proband) &&
+                                    (?proband = %{proband}))
                         }
-                        FILTER ((?partner != ?proband) &&
-                                (?proband = <)" + proband->get_uri_str() + R"(>))
                     }
+                    BIND(false AS ?inferred_int)
                 }
-                BIND(false AS ?inferred_int)
             }
-        }
-        GROUP BY ?partner)";
+            GROUP BY ?partner)");
 
-    spdlog::debug("{}: The query: {}", __func__, query);
+        const common::column_table table = common::exec_templated_column_query(
+            world, model, query, {{ "proband", proband->get_uri_str() }});
 
-    common::exec_query_result res = common::exec_query(world, model, query, __func__);
-    const common::extract_data_table_result data_tuple = common::extract_data_table(res->results);
-    const common::data_table& data_table = std::get<1>(data_tuple);
+        if (!table.empty())
+        {
+            const auto uri_col = table.get_column_req("partner");
+            const auto inferred_col = table.get_column_req("inferred");
+
+            for (std::size_t row = 0; row < table.get_row_count(); ++row)
+            {
+                // The aggregate query yields a single row of unbound values if nothing matched
+                if (!table.get(row, uri_col))
+                {
+                    continue;
+                }
+
+                const std::optional<common::typed_cell> inferred =
+                    table.get_typed(row, inferred_col); // throws common_exception
+
+                partner_seq.emplace_back(
+                    std::string(table.get_req(row, uri_col)),
+                    (inferred && common::get_boolean(*inferred)));
+            }
+        }
+    }
 
-    if (data_table.empty())
+    if (partner_seq.empty())
     {
         spdlog::debug(
             "{}: No partners of proband {} were found", __func__, proband->get_uri_str());
@@ -330,35 +451,24 @@ std::vector<common::Person::PartnerRelation> retrieve_person_partners(
 
     std::vector<common::Person::PartnerRelation> partners;
 
-    for (const common::data_row& row : data_table)
+    for (const auto& [partner_uri, inferred] : partner_seq)
     {
-        if (row.empty())
-        {
-            continue;
-        }
-
-        const auto& uri_it = common::get_binding_value_req(row, "partner");
-        const auto& inferred_it = common::get_binding_value_req(row, "inferred");
-        const bool inferred = (inferred_it->second == "true");
-
-        auto partner = retrieve_person_base_data_opt(uri_it->second, world, model);
+        auto partner = persons.get_base_data_opt(partner_uri);
 
         if (!partner)
         {
             if (inferred)
             {
-                notes.emplace_back(create_invalid_inferred_partner_note(uri_it->second));
+                notes.emplace_back(create_invalid_inferred_partner_note(partner_uri));
             }
             else
             {
-                notes.emplace_back(create_invalid_stated_partner_note(uri_it->second));
+                notes.emplace_back(create_invalid_stated_partner_note(partner_uri));
             }
 
             continue;
         }
 
-        retrieve_person_name(*partner, world, model);
-
         if (inferred)
         {
             notes.emplace_back(create_inferred_partner_note(partner));
@@ -370,4 +480,162 @@ std::vector<common::Person::PartnerRelation> retrieve_person_partners(
     return partners;
 }
 
+relatives_lookup_pool::relatives_lookup_pool(
+    std::size_t context_count, common::storage_backend backend)
+    : m_ctxs(common::create_redland_ctx_copies(
+          std::min(context_count, k_max_context_count), backend)) // throws common_exception
+{
+    m_identity_maps.reserve(m_ctxs.size());
+
+    for (const common::scoped_redland_ctx& ctx : m_ctxs)
+    {
+        m_identity_maps.emplace_back(ctx->world, ctx->model);
+    }
+}
+
+void relatives_lookup_pool::fill(const common::rdf_triple_buffer& triples)
+{
+    for (const common::scoped_redland_ctx& ctx : m_ctxs)
+    {
+        common::fill_redland_ctx_copy(*ctx, triples); // throws common_exception
+    }
+}
+
+namespace
+{
+
+/** @brief The results of the relative lookups (with the notes kept apart until the merge) */
+struct relatives_result
+{
+    std::shared_ptr<common::Person> father;
+    std::vector<common::Note> father_notes;
+    std::shared_ptr<common::Person> mother;
+    std::vector<common::Note> mother_notes;
+    std::vector<common::Person::PartnerRelation> partners;
+    std::vector<common::Note> partner_notes;
+    /** The proband stand-in receiving the children */
+    std::optional<common::Person> children_holder;
+};
+
+constexpr std::size_t k_relative_lookup_count = 4;
+
+/** @brief Run the relative lookup of the given index and store its result
+ *
+ *  The lookup exception is stored in the @p failure, so it never escapes a worker thread. */
+void run_relative_lookup(
+    std::size_t lookup_idx, const common::Person& proband, query_backend backend,
+    const family_graph* graph, person_identity_map& persons, relatives_result& result,
+    std::exception_ptr& failure)
+{
+    librdf_world* world = persons.get_world();
+    librdf_model* model = persons.get_model();
+
+    try
+    {
+        switch (lookup_idx)
+        {
+        case 0:
+            result.father = retrieve_person_father(
+                &proband, world, model, result.father_notes, backend, &persons, graph);
+            break;
+        case 1:
+            result.mother = retrieve_person_mother(
+                &proband, world, model, result.mother_notes, backend, &persons, graph);
+            break;
+        case 2:
+            result.partners = retrieve_person_partners(
+                &proband, world, model, result.partner_notes, backend, &persons, graph);
+            break;
+        case 3:
+            result.children_holder.emplace(proband.get_uri_str());
+            retrieve_person_children(
+                *result.children_holder, world, model, backend, &persons, graph);
+            break;
+        default:
+            assert(false && "Unexpected relative lookup index");
+        }
+    }
+    catch (...)
+    {
+        failure = std::current_exception();
+    }
+}
+
+} // anonymous namespace
+
+void retrieve_person_relatives(
+    common::Person& proband, librdf_world* world, librdf_model* model,
+    const relatives_query_options& options, person_identity_map* identity_map)
+{
+    spdlog::trace("{}: Entry checkpoint", __func__);
+
+    person_identity_map local_persons(world, model);
+    person_identity_map& persons = (identity_map ? *identity_map : local_persons);
+
+    if (!options.pool || (options.pool->get_context_count() == 0))
+    {
+        proband.father = retrieve_person_father(
+            &proband, world, model, proband.notes(), options.backend, &persons, options.graph);
+        proband.mother = retrieve_person_mother(
+            &proband, world, model, proband.notes(), options.backend, &persons, options.graph);
+        proband.partners = retrieve_person_partners(
+            &proband, world, model, proband.notes(), options.backend, &persons, options.graph);
+
+        retrieve_person_children(
+            proband, world, model, options.backend, &persons, options.graph);
+
+        return;
+    }
+
+    const std::size_t ctx_count = options.pool->get_context_count();
+    relatives_result result;
+    std::array<std::exception_ptr, k_relative_lookup_count> failures;
+
+    {
+        /* The lookups write to the distinct result members and each context is used by a single
+         * thread, so no synchronization is needed */
+        std::vector<std::jthread> workers;
+        workers.reserve(ctx_count);
+
+        for (std::size_t ctx_idx = 0; ctx_idx < ctx_count; ++ctx_idx)
+        {
+            workers.emplace_back([&, ctx_idx]() {
+                person_identity_map& ctx_persons = options.pool->get_identity_map(ctx_idx);
+
+                // The lookups but the first one are dealt out to the contexts round robin
+                for (std::size_t idx = ctx_idx + 1; idx < k_relative_lookup_count;
+                     idx += ctx_count)
+                {
+                    run_relative_lookup(
+                        idx, proband, options.backend, options.graph, ctx_persons, result,
+                        failures[idx]);
+                }
+            });
+        }
+
+        run_relative_lookup(
+            0, proband, options.backend, options.graph, persons, result, failures[0]);
+    }
+
+    for (const std::exception_ptr& failure : failures)
+    {
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    // The notes are merged in the sequential lookup order
+    proband.father = std::move(result.father);
+    proband.mother = std::move(result.mother);
+    proband.partners = std::move(result.partners);
+    proband.children = std::move(result.children_holder->children);
+
+    for (std::vector<common::Note>* notes :
+             { &result.father_notes, &result.mother_notes, &result.partner_notes })
+    {
+        std::ranges::move(*notes, std::back_inserter(proband.notes()));
+    }
+}
+
 } // namespace person
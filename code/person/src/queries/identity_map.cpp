@@ -0,0 +1,159 @@
+#include "person/queries/identity_map.hpp"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "person/error.hpp"
+#include "person/queries/common.hpp"
+
+namespace person
+{
+
+namespace
+{
+
+[[noreturn]] void throw_person_not_found(const std::string& person_uri)
+{
+    throw person_exception(
+        person_exception::error_code::resource_not_found,
+        fmt::format("Person not found: '{}'", person_uri));
+}
+
+} // anonymous namespace
+
+person_identity_map::person_identity_map(librdf_world* world, librdf_model* model)
+    : m_world(world), m_model(model)
+{
+    if (!world)
+    {
+        throw person_exception(
+            person_exception::error_code::input_contract_error,
+            fmt::format(
+                "Precondition failure: world={} must satisfy !nullptr", fmt::ptr(world)));
+    }
+
+    if (!model)
+    {
+        throw person_exception(
+            person_exception::error_code::input_contract_error,
+            fmt::format(
+                "Precondition failure: model={} must satisfy !nullptr", fmt::ptr(model)));
+    }
+}
+
+std::shared_ptr<common::Person> person_identity_map::get_caption_data_opt(
+    const std::string& person_uri)
+{
+    const auto it = m_entries.find(person_uri);
+
+    if (it != m_entries.end())
+    {
+        spdlog::trace("{}: Cache hit ({})", __func__, person_uri);
+
+        return it->second.person;
+    }
+
+    std::shared_ptr<common::Person> person =
+        retrieve_person_caption_data_opt(person_uri, m_world, m_model);
+
+    m_entries.emplace(
+        person_uri, entry{ person, (person ? data_level::caption : data_level::missing) });
+
+    return person;
+}
+
+std::shared_ptr<common::Person> person_identity_map::get_caption_data_req(
+    const std::string& person_uri)
+{
+    std::shared_ptr<common::Person> person = get_caption_data_opt(person_uri);
+
+    if (!person)
+    {
+        spdlog::error("{}: Person not found: {}", __func__, person_uri);
+
+        throw_person_not_found(person_uri);
+    }
+
+    return person;
+}
+
+std::vector<std::shared_ptr<common::Person>> person_identity_map::get_caption_data_seq_req(
+    const std::vector<std::string>& person_uri_seq)
+{
+    std::vector<std::shared_ptr<common::Person>> result;
+    result.reserve(person_uri_seq.size());
+
+    for (const auto& person_uri : person_uri_seq)
+    {
+        result.push_back(get_caption_data_req(person_uri));
+    }
+
+    return result;
+}
+
+std::shared_ptr<common::Person> person_identity_map::get_base_data_opt(
+    const std::string& person_uri)
+{
+    auto it = m_entries.find(person_uri);
+
+    if (it != m_entries.end())
+    {
+        if (it->second.level != data_level::caption)
+        {
+            spdlog::trace("{}: Cache hit ({})", __func__, person_uri);
+
+            return it->second.person;
+        }
+
+        // Upgrade the caption data in place, so all the holders of the person see the base data
+        std::shared_ptr<common::Person> base =
+            retrieve_person_base_data_opt(person_uri, m_world, m_model);
+        common::Person& person = *it->second.person;
+
+        if (base)
+        {
+            person.gender = base->gender;
+            person.birth_date = base->birth_date;
+            person.death_date = base->death_date;
+
+            for (const common::Note& note : base->notes())
+            {
+                person.add_note(note);
+            }
+        }
+
+        it->second.level = data_level::base;
+
+        return it->second.person;
+    }
+
+    std::shared_ptr<common::Person> person =
+        retrieve_person_base_data_opt(person_uri, m_world, m_model);
+
+    if (person)
+    {
+        retrieve_person_name(*person, m_world, m_model);
+    }
+
+    m_entries.emplace(
+        person_uri, entry{ person, (person ? data_level::base : data_level::missing) });
+
+    return person;
+}
+
+std::shared_ptr<common::Person> person_identity_map::get_base_data_req(
+    const std::string& person_uri)
+{
+    std::shared_ptr<common::Person> person = get_base_data_opt(person_uri);
+
+    if (!person)
+    {
+        spdlog::error("{}: Person not found: {}", __func__, person_uri);
+
+        throw_person_not_found(person_uri);
+    }
+
+    return person;
+}
+
+} // namespace person
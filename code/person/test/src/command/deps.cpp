@@ -1,9 +1,16 @@
+#include <filesystem>
 #include <map>
+#include <memory>
+#include <ostream>
 #include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
 
 #include <gtest/gtest.h>
 
 #include "common/resource.hpp"
+#include "person/command/targets.hpp"
 
 //  The merge_dependencies function tests
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
@@ -237,3 +244,171 @@ INSTANTIATE_TEST_SUITE_P(
 } // anonymous namespace
 
 } // namespace test
+
+//  The print_person_dependencies function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+// The print_person_dependencies function is not declared in any header either
+namespace person::detail
+{
+void print_person_dependencies(
+    const common::resource_id&, const common::file_set&, const std::filesystem::path&,
+    const std::string_view&, const std::string&, std::ostream&);
+} // namespace person::detail
+
+namespace test
+{
+
+TEST(DepsCommand_PrintPersonDependencies, ConcatenatedRules)
+{
+    std::ostringstream os;
+
+    person::detail::print_person_dependencies(
+        "example.org/P1", { "data/1.ttl", "data/2.ttl" }, "int/person", "json", "int_person_all",
+        os);
+    person::detail::print_person_dependencies(
+        "example.org/P2", { "data/2.ttl" }, "int/person", "json", "int_person_all", os);
+
+    EXPECT_EQ(
+        "int/person/example.org/P1.json: \\\n"
+        "\t\tdata/1.ttl \\\n"
+        "\t\tdata/2.ttl\n"
+        "\n"
+        "int_person_all: int/person/example.org/P1.json\n"
+        "\n"
+        "int/person/example.org/P2.json: \\\n"
+        "\t\tdata/2.ttl\n"
+        "\n"
+        "int_person_all: int/person/example.org/P2.json\n"
+        "\n",
+        os.str());
+}
+
+} // namespace test
+
+//  The print_person_dyndep function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+// The print_person_dyndep and print_dyndep_header functions are not declared in any header either
+namespace person::detail
+{
+void print_person_dyndep(
+    const common::resource_id&, const common::file_set&, const std::filesystem::path&,
+    const std::string_view&, std::ostream&);
+void print_dyndep_header(std::ostream&);
+} // namespace person::detail
+
+namespace test
+{
+
+TEST(DepsCommand_PrintPersonDyndep, ConcatenatedEntries)
+{
+    std::ostringstream os;
+
+    person::detail::print_dyndep_header(os);
+    person::detail::print_person_dyndep(
+        "example.org/P1", { "data/1.ttl", "data/my data/2.ttl" }, "int/person", "json", os);
+    person::detail::print_person_dyndep("example.org/P2", {}, "c:/int", "json", os);
+
+    EXPECT_EQ(
+        "ninja_dyndep_version = 1\n"
+        "\n"
+        "build int/person/example.org/P1.json: dyndep | $\n"
+        "    data/1.ttl $\n"
+        "    data/my$ data/2.ttl\n"
+        "\n"
+        "build c$:/int/example.org/P2.json: dyndep\n"
+        "\n",
+        os.str());
+}
+
+} // namespace test
+
+//  The ninja targets and dyndep files interplay tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test
+{
+
+namespace {
+
+/** @brief Collect the outputs of the build statements of the given rule */
+std::set<std::string> collect_build_outputs(const std::string& ninja_text, std::string_view rule)
+{
+    std::set<std::string> result;
+    std::istringstream is(ninja_text);
+    std::string line;
+
+    while (std::getline(is, line))
+    {
+        if (!line.starts_with("build "))
+        {
+            continue;
+        }
+
+        // The escaped colons ('$:') are never followed by the space
+        const std::size_t colon_pos = line.find(": ");
+        const std::string_view statement_rule = std::string_view(line).substr(colon_pos + 2);
+
+        if (statement_rule.substr(0, statement_rule.find(' ')) == rule)
+        {
+            result.insert(line.substr(6, colon_pos - 6));
+        }
+    }
+
+    return result;
+}
+
+} // anonymous namespace
+
+// The dyndep file of the deps command has to list every HTML target of the targets command and
+//  the targets fragment has to produce the dyndep file
+TEST(DepsCommand_NinjaDyndep, HtmlTargetsMatchDyndepEntries)
+{
+    const common::resource_set persons {
+        std::make_shared<common::Resource>("http://example.org/P1"),
+        std::make_shared<common::Resource>("http://example.org/P2")
+    };
+
+    std::ostringstream targets_os;
+
+    person::detail::print_ninja_targets(
+        persons, "out/person", "html", "person_html",
+        person::detail::ninja_dyndep_edge {
+            .path = "out/person.dd",
+            .rule_name = "person_deps",
+            .input_paths = { "data/1.ttl", "data/2.ttl" }
+        },
+        "person_all", targets_os);
+
+    std::ostringstream dyndep_os;
+    person::detail::print_dyndep_header(dyndep_os);
+
+    for (const auto& person : persons)
+    {
+        person::detail::print_person_dyndep(
+            person->get_unique_id(), { "data/1.ttl" }, "out/person", "html", dyndep_os);
+    }
+
+    const std::string targets_text = targets_os.str();
+
+    EXPECT_EQ(
+        collect_build_outputs(targets_text, "person_html"),
+        std::set<std::string>({
+            "out/person/example.org/P1.html", "out/person/example.org/P2.html" }));
+    EXPECT_EQ(
+        collect_build_outputs(targets_text, "person_html"),
+        collect_build_outputs(dyndep_os.str(), "dyndep"));
+    EXPECT_NE(
+        targets_text.find(
+            "build out/person.dd: person_deps $\n    data/1.ttl $\n    data/2.ttl\n\n"),
+        std::string::npos);
+    EXPECT_NE(
+        targets_text.find(
+            "build out/person/example.org/P1.html: person_html || out/person.dd\n"
+            "  person_uri = http://example.org/P1\n"
+            "  dyndep = out/person.dd\n"),
+        std::string::npos);
+}
+
+} // namespace test
@@ -0,0 +1,220 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/tools/application.hpp"
+#include "test/tools/gtest.hpp"
+#include "test/tools/redland.hpp"
+
+#include "common/common_exception.hpp"
+#include "common/resource.hpp"
+#include "person/command/common.hpp"
+#include "person/command/details.hpp"
+#include "person/queries/common.hpp"
+
+//  The write_person_details function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test
+{
+
+namespace suite_write_person_details
+{
+
+struct Param
+{
+    const char* case_name;
+    std::string model_path;
+    unsigned int thread_count;
+    unsigned int query_thread_count;
+    person::output_format format;
+};
+
+class DetailsCommand_WritePersonDetails : public ::testing::TestWithParam<Param> {};
+
+std::string read_file(const std::filesystem::path& file_path)
+{
+    std::ifstream is(file_path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+}
+
+// The bulk generated files are expected to match the single person details command output
+TEST_P(DetailsCommand_WritePersonDetails, MatchesSinglePersonOutput)
+{
+    const Param& param = GetParam();
+
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / param.model_path);
+
+    std::vector<std::string> person_uris;
+
+    for (const std::shared_ptr<common::Resource>& resource :
+             person::retrieve_person_uris(ctx->world, ctx->model))
+    {
+        person_uris.emplace_back(resource->get_uri_str());
+    }
+
+    ASSERT_FALSE(person_uris.empty());
+
+    const std::filesystem::path tgt_root_path =
+        std::filesystem::temp_directory_path() / "gen_person_test" / "write_person_details" /
+        param.case_name;
+    std::filesystem::remove_all(tgt_root_path);
+
+    const person::detail::details_write_stats stats = person::detail::write_person_details(
+        person_uris, ctx->world, ctx->model, tgt_root_path, person::query_backend::sparql,
+        common::storage_backend::memory, param.thread_count, param.query_thread_count,
+        param.format);
+
+    EXPECT_EQ(stats.written_count, person_uris.size());
+    EXPECT_EQ(stats.unchanged_count, 0U);
+
+    for (const std::string& person_uri : person_uris)
+    {
+        person::person_identity_map persons(ctx->world, ctx->model);
+        const std::string expected_content = person::encode_document(
+            person::detail::retrieve_person_details(
+                person_uri, ctx->world, ctx->model, {}, persons),
+            param.format);
+        const std::filesystem::path file_path =
+            (tgt_root_path / common::Resource(person_uri).get_unique_id()).replace_extension(
+                person::get_output_extension(param.format));
+
+        EXPECT_EQ(expected_content, read_file(file_path)) << person_uri;
+    }
+
+    // The regeneration of the unchanged data is expected to leave the files untouched
+    const std::filesystem::path first_file_path =
+        (tgt_root_path / common::Resource(person_uris.front()).get_unique_id()).replace_extension(
+            person::get_output_extension(param.format));
+    const std::filesystem::file_time_type first_write_time =
+        std::filesystem::last_write_time(first_file_path);
+
+    const person::detail::details_write_stats restats = person::detail::write_person_details(
+        person_uris, ctx->world, ctx->model, tgt_root_path, person::query_backend::sparql,
+        common::storage_backend::memory, param.thread_count, param.query_thread_count,
+        param.format);
+
+    EXPECT_EQ(restats.written_count, 0U);
+    EXPECT_EQ(restats.unchanged_count, person_uris.size());
+    EXPECT_EQ(first_write_time, std::filesystem::last_write_time(first_file_path));
+
+    std::filesystem::remove_all(tgt_root_path);
+}
+
+const std::vector<Param> g_params{
+    {
+        .case_name="SingleThread",
+        .model_path=(
+            "data/queries/details/retrieve_person_partners/"
+            "model-05_three-generations-some-inferred.ttl"),
+        .thread_count=1,
+        .query_thread_count=1,
+        .format=person::output_format::pretty
+    },
+    {
+        .case_name="FourThreads",
+        .model_path=(
+            "data/queries/details/retrieve_person_partners/"
+            "model-05_three-generations-some-inferred.ttl"),
+        .thread_count=4,
+        .query_thread_count=1,
+        .format=person::output_format::pretty
+    },
+    {
+        .case_name="MoreThreadsThanPersons",
+        .model_path="data/queries/details/retrieve_person_partners/model-07_three-couples.ttl",
+        .thread_count=64,
+        .query_thread_count=1,
+        .format=person::output_format::pretty
+    },
+    {
+        .case_name="CompactFormat",
+        .model_path="data/queries/details/retrieve_person_partners/model-07_three-couples.ttl",
+        .thread_count=2,
+        .query_thread_count=1,
+        .format=person::output_format::compact
+    },
+    {
+        .case_name="CborFormat",
+        .model_path="data/queries/details/retrieve_person_partners/model-07_three-couples.ttl",
+        .thread_count=2,
+        .query_thread_count=1,
+        .format=person::output_format::cbor
+    },
+    {
+        .case_name="PooledRelativeLookups",
+        .model_path=(
+            "data/queries/details/retrieve_person_partners/"
+            "model-05_three-generations-some-inferred.ttl"),
+        .thread_count=1,
+        .query_thread_count=4,
+        .format=person::output_format::pretty
+    },
+    {
+        .case_name="PooledRelativeLookupsTwoThreads",
+        .model_path="data/queries/details/retrieve_person_partners/model-07_three-couples.ttl",
+        .thread_count=2,
+        .query_thread_count=2,
+        .format=person::output_format::pretty
+    },
+    {
+        .case_name="MsgpackFormat",
+        .model_path="data/queries/details/retrieve_person_partners/model-07_three-couples.ttl",
+        .thread_count=1,
+        .query_thread_count=1,
+        .format=person::output_format::msgpack
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    , DetailsCommand_WritePersonDetails, ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+} // namespace suite_write_person_details
+
+//  The read_person_uri_list function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace suite_read_person_uri_list
+{
+
+TEST(DetailsCommand_ReadPersonUriList, SkipsBlankAndCommentLines)
+{
+    const std::filesystem::path list_path =
+        std::filesystem::temp_directory_path() / "gen_person_test_person_list.txt";
+
+    {
+        std::ofstream os(list_path);
+        os << "# The persons to process\n"
+           << "http://example.org/P1\n"
+           << "\n"
+           << "  http://example.org/P2  \r\n"
+           << "   # http://example.org/P3\n"
+           << "http://example.org/P4";
+    }
+
+    const std::vector<std::string> expected {
+        "http://example.org/P1", "http://example.org/P2", "http://example.org/P4" };
+
+    EXPECT_EQ(expected, person::detail::read_person_uri_list(list_path));
+
+    std::filesystem::remove(list_path);
+}
+
+TEST(DetailsCommand_ReadPersonUriList, MissingFile)
+{
+    EXPECT_THROW(
+        std::ignore = person::detail::read_person_uri_list("non/existent/person_list.txt"),
+        common::common_exception);
+}
+
+} // namespace suite_read_person_uri_list
+
+} // namespace test
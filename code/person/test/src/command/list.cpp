@@ -0,0 +1,112 @@
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <redland.h>
+
+#include "common/person.hpp"
+#include "person/option_parser.hpp"
+#include "person/queries/common.hpp"
+
+#include "test/tools/gtest.hpp"
+#include "test/tools/redland.hpp"
+
+//  The write_binary_person_list function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+// The write_binary_person_list function is not declared in any header, so it has to be introduced
+//  here
+namespace person::detail
+{
+void write_binary_person_list(
+    librdf_world* world, librdf_model* model, output_format format, std::ostream& os);
+} // namespace person::detail
+
+namespace test::suite_write_binary_person_list
+{
+
+struct Param
+{
+    const char* case_name;
+    person::output_format format;
+    std::size_t person_count;
+};
+
+class ListCommand_WriteBinaryPersonList : public ::testing::TestWithParam<Param> {};
+
+// The binary output decodes to the same document as the one produced by person_list_to_json, so
+//  the streamed CBOR array and each MessagePack array header (fixarray, array 16 and array 32) are
+//  checked against the in-memory encoding
+TEST_P(ListCommand_WriteBinaryPersonList, MatchesPersonListToJson)
+{
+    const Param& param = GetParam();
+    test::tools::scoped_redland_ctx ctx = test::tools::initialize_redland_ctx();
+
+    for (std::size_t idx = 0; idx < param.person_count; ++idx)
+    {
+        char person_uri[32];
+        std::snprintf(person_uri, sizeof(person_uri), "http://example.org/P%05zu", idx);
+
+        test::tools::insert_uuu_statement(
+            ctx->world, ctx->model,
+            person_uri,
+            "http://www.w3.org/1999/02/22-rdf-syntax-ns#type",
+            "http://gedcomx.org/Person");
+    }
+
+    std::ostringstream os;
+    person::detail::write_binary_person_list(ctx->world, ctx->model, param.format, os);
+    const std::string output = os.str();
+
+    const nlohmann::json actual_document = (
+        param.format == person::output_format::cbor
+            ? nlohmann::json::from_cbor(output)
+            : nlohmann::json::from_msgpack(output));
+    const nlohmann::json expected_document =
+        common::person_list_to_json(person::retrieve_person_list(ctx->world, ctx->model));
+
+    EXPECT_EQ(expected_document, actual_document);
+    EXPECT_EQ(param.person_count == 0, actual_document.is_null());
+
+    if (param.person_count != 0)
+    {
+        EXPECT_EQ(param.person_count, actual_document.size());
+    }
+}
+
+const std::vector<Param> g_params {
+    { .case_name="CborEmptyList", .format=person::output_format::cbor, .person_count=0 },
+    { .case_name="CborFifteenPersons", .format=person::output_format::cbor, .person_count=15 },
+    { .case_name="CborSixteenPersons", .format=person::output_format::cbor, .person_count=16 },
+    { .case_name="CborManyPersons", .format=person::output_format::cbor, .person_count=65537 },
+    { .case_name="MsgpackEmptyList", .format=person::output_format::msgpack, .person_count=0 },
+    {
+        .case_name="MsgpackFixArray",
+        .format=person::output_format::msgpack,
+        .person_count=15
+    },
+    {
+        .case_name="MsgpackArray16",
+        .format=person::output_format::msgpack,
+        .person_count=16
+    },
+    {
+        .case_name="MsgpackArray32",
+        .format=person::output_format::msgpack,
+        .person_count=65537
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    ListCommand_WriteBinaryPersonList,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>
+);
+
+} // namespace test::suite_write_binary_person_list
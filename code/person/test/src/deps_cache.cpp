@@ -0,0 +1,168 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "person/deps_cache.hpp"
+
+//  The deps cache tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_deps_cache
+{
+
+namespace {
+
+common::rdf_term uri(const char* value)
+{
+    return { .type=common::rdf_term::kind::uri, .value=value, .datatype={}, .language={} };
+}
+
+common::rdf_term literal(const char* value)
+{
+    return { .type=common::rdf_term::kind::literal, .value=value, .datatype={}, .language={} };
+}
+
+constexpr const char* k_type = "http://www.w3.org/1999/02/22-rdf-syntax-ns#type";
+constexpr const char* k_person = "http://gedcomx.org/Person";
+constexpr const char* k_gender = "http://gedcomx.org/gender";
+constexpr const char* k_person1 = "http://gedcomx.org/person1";
+constexpr const char* k_name = "http://gedcomx.org/name";
+
+const char* const k_ttl_prefixes =
+    "@prefix gx: <http://gedcomx.org/> .\n"
+    "@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n";
+
+std::filesystem::path prepare_dir(const char* case_name)
+{
+    const std::filesystem::path dir_path =
+        std::filesystem::temp_directory_path() / "gen_person_test" / "deps_cache" / case_name;
+    std::filesystem::remove_all(dir_path);
+    std::filesystem::create_directories(dir_path);
+    return dir_path;
+}
+
+void write_ttl(const std::filesystem::path& file_path, const std::string& statements)
+{
+    std::ofstream os(file_path, std::ios::binary);
+    os << k_ttl_prefixes << statements;
+}
+
+} // anonymous namespace
+
+TEST(DepsCache_ExtractDepsFacts, FiltersStatements)
+{
+    const common::rdf_triple_buffer triples = {
+        { .subject=uri("http://example.org/P1"), .predicate=uri(k_type), .object=uri(k_person) },
+        { .subject=uri("http://example.org/P1"), .predicate=uri(k_name), .object=literal("A") },
+        { .subject=uri("http://example.org/R1"), .predicate=uri(k_person1),
+          .object=uri("http://example.org/P1") },
+        { .subject=uri("http://example.org/P2"), .predicate=uri(k_gender),
+          .object=uri("http://gedcomx.org/Male") }
+    };
+
+    const person::deps_facts facts = person::extract_deps_facts(triples);
+
+    EXPECT_EQ(
+        facts.subjects,
+        std::vector<std::string>({
+            "http://example.org/P1", "http://example.org/R1", "http://example.org/P2" }));
+    EXPECT_EQ(
+        facts.family_triples, common::rdf_triple_buffer({ triples[0], triples[2], triples[3] }));
+}
+
+TEST(DepsCache_ReadDepsCache, MissingFile)
+{
+    const std::filesystem::path dir_path = prepare_dir("missing_file");
+
+    EXPECT_TRUE(person::read_deps_cache(dir_path / "deps.cache").empty());
+}
+
+TEST(DepsCache_ReadDepsCache, MalformedFile)
+{
+    const std::filesystem::path dir_path = prepare_dir("malformed_file");
+    std::ofstream(dir_path / "deps.cache") << "not a cache";
+
+    EXPECT_TRUE(person::read_deps_cache(dir_path / "deps.cache").empty());
+}
+
+TEST(DepsCache_WriteDepsCache, RoundTrip)
+{
+    const std::filesystem::path dir_path = prepare_dir("round_trip");
+
+    person::deps_cache cache;
+    person::deps_cache_entry& entry = cache[dir_path / "a.ttl"];
+    entry.fingerprint = common::file_fingerprint { .size=42, .mtime=7, .content_hash=0x1234 };
+    entry.facts.subjects = { "http://example.org/P1" };
+    entry.facts.family_triples = {
+        { .subject=uri("http://example.org/P1"), .predicate=uri(k_type), .object=uri(k_person) },
+        { .subject={ .type=common::rdf_term::kind::blank, .value="b1", .datatype={},
+                     .language={} },
+          .predicate=uri(k_name),
+          .object={ .type=common::rdf_term::kind::literal, .value="x",
+                    .datatype="http://www.w3.org/2001/XMLSchema#string", .language="en" } }
+    };
+
+    person::write_deps_cache(dir_path / "deps.cache", cache);
+
+    EXPECT_EQ(person::read_deps_cache(dir_path / "deps.cache"), cache);
+}
+
+// The unchanged files keep their cached facts, the changed files are re-parsed and the files no
+//  longer present in the input set are dropped
+TEST(DepsCache_UpdateDepsCache, ChangedInputFiles)
+{
+    const std::filesystem::path dir_path = prepare_dir("changed_input_files");
+    const std::filesystem::path cache_path = dir_path / "deps.cache";
+    const std::filesystem::path a_path = dir_path / "a.ttl";
+    const std::filesystem::path b_path = dir_path / "b.ttl";
+
+    write_ttl(a_path, "<http://example.org/P1> rdf:type gx:Person .\n");
+    write_ttl(b_path, "<http://example.org/P2> rdf:type gx:Person .\n");
+
+    const person::deps_cache first = person::update_deps_cache({ a_path, b_path }, 1, cache_path);
+
+    ASSERT_EQ(first.size(), 2U);
+    EXPECT_EQ(
+        first.at(a_path).facts.subjects, std::vector<std::string>({ "http://example.org/P1" }));
+    EXPECT_EQ(person::read_deps_cache(cache_path), first);
+
+    write_ttl(
+        a_path,
+        "<http://example.org/P1> rdf:type gx:Person .\n"
+        "<http://example.org/P3> rdf:type gx:Person .\n");
+
+    const person::deps_cache second = person::update_deps_cache({ a_path }, 1, cache_path);
+
+    ASSERT_EQ(second.size(), 1U);
+    EXPECT_EQ(
+        second.at(a_path).facts.subjects,
+        std::vector<std::string>({ "http://example.org/P1", "http://example.org/P3" }));
+    EXPECT_EQ(second.at(a_path).facts.family_triples.size(), 2U);
+    EXPECT_EQ(person::read_deps_cache(cache_path), second);
+}
+
+// The facts of the file failed to parse are returned, but they aren't written to the cache file
+TEST(DepsCache_UpdateDepsCache, MalformedInputFile)
+{
+    const std::filesystem::path dir_path = prepare_dir("malformed_input_file");
+    const std::filesystem::path cache_path = dir_path / "deps.cache";
+    const std::filesystem::path a_path = dir_path / "a.ttl";
+    const std::filesystem::path b_path = dir_path / "b.ttl";
+
+    write_ttl(a_path, "<http://example.org/P1> rdf:type gx:Person .\n");
+    write_ttl(b_path, "<http://example.org/P2> rdf:type gx:Person .\n<http://example.org/P3> .\n");
+
+    const person::deps_cache first = person::update_deps_cache({ a_path, b_path }, 1, cache_path);
+
+    EXPECT_EQ(first.size(), 2U);
+
+    const person::deps_cache cached = person::read_deps_cache(cache_path);
+
+    EXPECT_TRUE(cached.contains(a_path));
+    EXPECT_FALSE(cached.contains(b_path));
+}
+
+} // namespace test::suite_deps_cache
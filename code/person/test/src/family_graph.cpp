@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/tools/application.hpp"
+#include "test/tools/redland.hpp"
+
+#include "person/family_graph.hpp"
+#include "person/queries/deps.hpp"
+
+//  The family_graph tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_family_graph
+{
+
+namespace {
+
+using uri_pair_set = std::set<std::pair<std::string, std::string>>;
+
+common::rdf_term uri(const char* value)
+{
+    return { .type=common::rdf_term::kind::uri, .value=value, .datatype={}, .language={} };
+}
+
+common::rdf_triple triple(const char* s, const char* p, const char* o)
+{
+    return { .subject=uri(s), .predicate=uri(p), .object=uri(o) };
+}
+
+constexpr const char* k_type = "http://www.w3.org/1999/02/22-rdf-syntax-ns#type";
+constexpr const char* k_person = "http://gedcomx.org/Person";
+constexpr const char* k_relationship = "http://gedcomx.org/Relationship";
+constexpr const char* k_gx_type = "http://gedcomx.org/type";
+constexpr const char* k_person1 = "http://gedcomx.org/person1";
+constexpr const char* k_person2 = "http://gedcomx.org/person2";
+constexpr const char* k_parent_child = "http://gedcomx.org/ParentChild";
+constexpr const char* k_couple = "http://gedcomx.org/Couple";
+constexpr const char* k_gender = "http://gedcomx.org/gender";
+constexpr const char* k_gender_class = "http://gedcomx.org/Gender";
+constexpr const char* k_male = "http://gedcomx.org/Male";
+constexpr const char* k_female = "http://gedcomx.org/Female";
+
+void add_relationship(
+    person::family_graph_builder& builder, const char* rel, const char* type, const char* p1,
+    const char* p2)
+{
+    builder.add_triple(triple(rel, k_person2, p2));
+    builder.add_triple(triple(rel, k_type, k_relationship));
+    builder.add_triple(triple(rel, k_person1, p1));
+    builder.add_triple(triple(rel, k_gx_type, type));
+}
+
+std::vector<std::string> to_uris(
+    const person::family_graph& graph, const std::vector<person::person_id>& ids)
+{
+    std::vector<std::string> result;
+
+    std::ranges::transform(
+        ids, std::back_inserter(result),
+        [&graph](person::person_id id) { return graph.get_uri(id); });
+
+    return result;
+}
+
+std::vector<std::string> to_uris(
+    const person::family_graph& graph, std::span<const person::family_edge> edges)
+{
+    std::vector<std::string> result;
+
+    std::ranges::transform(
+        edges, std::back_inserter(result),
+        [&graph](const person::family_edge& edge) { return graph.get_uri(edge.target); });
+
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(FamilyGraph, Adjacency)
+{
+    person::family_graph_builder builder;
+
+    // Two parents (ex:F, ex:M) with two children (ex:C1, ex:C2) and a stated couple of ex:F with
+    //  ex:W. The ex:X resource isn't a person, it is indexed as a non-person node.
+    add_relationship(builder, "http://ex/R4", k_couple, "http://ex/W", "http://ex/F");
+    add_relationship(builder, "http://ex/R1", k_parent_child, "http://ex/F", "http://ex/C1");
+    add_relationship(builder, "http://ex/R2", k_parent_child, "http://ex/M", "http://ex/C1");
+    add_relationship(builder, "http://ex/R3", k_parent_child, "http://ex/F", "http://ex/C2");
+    add_relationship(builder, "http://ex/R5", k_parent_child, "http://ex/X", "http://ex/C2");
+    // A duplicate relationship is collapsed into a single edge
+    add_relationship(builder, "http://ex/R6", k_parent_child, "http://ex/F", "http://ex/C2");
+
+    for (const char* p : { "http://ex/F", "http://ex/M", "http://ex/C1", "http://ex/C2",
+                           "http://ex/W" })
+    {
+        builder.add_triple(triple(p, k_type, k_person));
+    }
+
+    builder.add_triple(triple("http://ex/F", k_gender, "http://ex/G1"));
+    builder.add_triple(triple("http://ex/G1", k_type, k_gender_class));
+    builder.add_triple(triple("http://ex/G1", k_gx_type, k_male));
+    // The gender without the gx:Gender type is ignored
+    builder.add_triple(triple("http://ex/M", k_gender, "http://ex/G2"));
+    builder.add_triple(triple("http://ex/G2", k_gx_type, k_female));
+
+    const person::family_graph graph = builder.build();
+
+    ASSERT_EQ(graph.get_node_count(), 6);
+    ASSERT_EQ(graph.get_person_count(), 5);
+    EXPECT_EQ(graph.get_edge_count(), 5);
+    EXPECT_FALSE(graph.find_node("http://ex/R1").has_value());
+    EXPECT_FALSE(graph.find_node("http://ex/G1").has_value());
+
+    const person::person_id x = graph.find_node("http://ex/X").value();
+    const person::person_id f = graph.find_node("http://ex/F").value();
+    const person::person_id m = graph.find_node("http://ex/M").value();
+    const person::person_id c1 = graph.find_node("http://ex/C1").value();
+    const person::person_id c2 = graph.find_node("http://ex/C2").value();
+    const person::person_id w = graph.find_node("http://ex/W").value();
+
+    EXPECT_EQ(
+        to_uris(graph, graph.get_children(f)),
+        (std::vector<std::string>{ "http://ex/C1", "http://ex/C2" }));
+    EXPECT_EQ(
+        to_uris(graph, graph.get_parents(c1)),
+        (std::vector<std::string>{ "http://ex/F", "http://ex/M" }));
+    EXPECT_EQ(
+        to_uris(graph, graph.get_parents(c2)),
+        (std::vector<std::string>{ "http://ex/F", "http://ex/X" }));
+    EXPECT_EQ(to_uris(graph, graph.get_partners(f)), (std::vector<std::string>{ "http://ex/W" }));
+    EXPECT_EQ(to_uris(graph, graph.get_partners(w)), (std::vector<std::string>{ "http://ex/F" }));
+    EXPECT_EQ(
+        to_uris(graph, graph.get_inferred_partners(f)),
+        (std::vector<std::string>{ "http://ex/M", "http://ex/X" }));
+    EXPECT_TRUE(graph.get_children(w).empty());
+    EXPECT_FALSE(graph.is_person(x));
+    EXPECT_TRUE(graph.is_person(f));
+    EXPECT_TRUE(graph.is_male(f));
+    EXPECT_FALSE(graph.is_female(f));
+    EXPECT_FALSE(graph.is_male(m));
+    EXPECT_FALSE(graph.is_female(m));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+struct Param
+{
+    const char* case_name;
+    const char* data_file;
+};
+
+class FamilyGraph_RelatedPersons : public ::testing::TestWithParam<Param> {};
+
+// The related person pairs are expected to match the retrieve_related_persons query result
+TEST_P(FamilyGraph_RelatedPersons, MatchesQuery)
+{
+    const Param& param = GetParam();
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / param.data_file);
+
+    uri_pair_set expected_pairs;
+
+    for (const common::data_row& row : person::retrieve_related_persons(ctx->world, ctx->model))
+    {
+        expected_pairs.emplace(row.at("person1"), row.at("person2"));
+    }
+
+    const person::family_graph graph = person::build_family_graph(ctx->world, ctx->model);
+    uri_pair_set actual_pairs;
+
+    for (const auto& [id1, id2] : person::collect_related_person_pairs(graph))
+    {
+        actual_pairs.emplace(graph.get_uri(id1), graph.get_uri(id2));
+    }
+
+    EXPECT_EQ(expected_pairs, actual_pairs);
+}
+
+const std::vector<Param> g_params {
+    {
+        "SingleRelation",
+        "data/deps_queries/retrieve_related_persons/normal_success_cases/case0.ttl"
+    },
+    {
+        "SingleFamilyPlusOneUnrelated",
+        "data/deps_queries/retrieve_related_persons/normal_success_cases/case1.ttl"
+    },
+    {
+        "DuplicateRelation",
+        "data/deps_queries/retrieve_related_persons/normal_success_cases/case2.ttl"
+    },
+    {
+        "SingleFamilyInferred",
+        "data/deps_queries/retrieve_related_persons/normal_success_cases/"
+        "case3_single-family-inferred.ttl"
+    },
+    {
+        "ThreeGenerations",
+        "data/queries/details/retrieve_person_partners/model-03_three-generations.ttl"
+    }
+};
+
+std::string ParamNameGen(const ::testing::TestParamInfo<Param>& info)
+{
+    return { info.param.case_name };
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    FamilyGraph_RelatedPersons,
+    ::testing::ValuesIn(g_params),
+    ParamNameGen);
+
+} // namespace test::suite_family_graph
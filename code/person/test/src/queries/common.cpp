@@ -1,10 +1,14 @@
+#include <algorithm>
+#include <chrono>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include <boost/url.hpp>
 
+#include "common/person.hpp"
 #include "person/error.hpp"
 #include "person/queries/common.hpp"
 
@@ -464,3 +468,122 @@ INSTANTIATE_TEST_SUITE_P(
     tools::ParamNameGen<Param>);
 
 } // namespace test::suite_retrieve_person_caption_data_seq
+
+// The retrieve_person_list function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_retrieve_person_list
+{
+
+TEST(CommonQueries_RetrievePersonList, NamePrecedence)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(
+        ctx->world, ctx->model,
+        tools::get_program_path() /
+        "data/queries/common/retrieve_person_list/model-01_name-precedence.ttl");
+
+    std::vector<tools::ComparablePerson> actual_person_seq =
+        tools::to_comparable(person::retrieve_person_list(ctx->world, ctx->model));
+
+    std::ranges::sort(
+        actual_person_seq, {}, [](const tools::ComparablePerson& p) { return p.id; });
+
+    const std::vector<tools::ComparablePerson> expected_person_seq {
+        {
+            .id="http://example.org/Person1",
+            .caption="Navickienė, Ugnė"
+        },
+        {
+            .id="http://example.org/Person2",
+            .caption="Navickas, Domantas"
+        },
+        {
+            .id="http://example.org/Person3",
+            .caption="Justinas"
+        },
+        {
+            .id="http://example.org/Person4",
+            .caption=""
+        }
+    };
+
+    EXPECT_EQ(expected_person_seq, actual_person_seq);
+}
+
+TEST(CommonQueries_RetrievePersonList, PartialDates)
+{
+    using namespace std::chrono_literals;
+
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(
+        ctx->world, ctx->model,
+        tools::get_program_path() /
+        "data/queries/common/retrieve_person_list/model-02_partial-dates.ttl");
+
+    std::vector<std::shared_ptr<common::Person>> person_seq =
+        person::retrieve_person_list(ctx->world, ctx->model);
+
+    std::ranges::sort(person_seq, {}, [](const auto& p) { return p->get_uri_str(); });
+
+    ASSERT_EQ(person_seq.size(), 4);
+
+    EXPECT_EQ(person_seq[0]->birth_date, common::partial_date(1970y/5/12));
+    EXPECT_EQ(person_seq[0]->death_date, common::partial_date(2021y/1/3));
+    EXPECT_EQ(person_seq[1]->birth_date, common::partial_date(1968y, std::chrono::November));
+    EXPECT_EQ(person_seq[1]->death_date, common::partial_date(2020y, std::chrono::February));
+    EXPECT_EQ(person_seq[2]->birth_date, common::partial_date(1890y));
+    EXPECT_EQ(person_seq[2]->death_date, common::partial_date(950y));
+    EXPECT_EQ(person_seq[3]->birth_date, std::nullopt);
+    EXPECT_EQ(person_seq[3]->death_date, std::nullopt);
+
+    const nlohmann::json json = common::person_to_json(*person_seq[2]);
+    EXPECT_EQ(json["birth_date"], "1890");
+    EXPECT_EQ(json["death_date"], "0950");
+}
+
+TEST(CommonQueries_RetrievePersonList, MatchesSinglePersonNameRetrieval)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(
+        ctx->world, ctx->model,
+        tools::get_program_path() /
+        "data/queries/common/retrieve_person_caption_data/model-01_normal-success-cases.ttl");
+
+    for (const std::shared_ptr<common::Person>& listed :
+             person::retrieve_person_list(ctx->world, ctx->model))
+    {
+        common::Person single(listed->get_uri_str());
+        person::retrieve_person_name(single, ctx->world, ctx->model);
+
+        EXPECT_EQ(listed->given_names, single.given_names) << listed->get_uri_str();
+        EXPECT_EQ(listed->last_names, single.last_names) << listed->get_uri_str();
+    }
+}
+
+TEST(CommonQueries_RetrievePersonName, NamePrecedence)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(
+        ctx->world, ctx->model,
+        tools::get_program_path() /
+        "data/queries/common/retrieve_person_list/model-01_name-precedence.ttl");
+
+    const std::vector<std::tuple<std::string, person::retrieve_result, std::string>> cases {
+        { "http://example.org/Person1", person::retrieve_result::Success, "Navickienė, Ugnė" },
+        { "http://example.org/Person2", person::retrieve_result::Success, "Navickas, Domantas" },
+        { "http://example.org/Person3", person::retrieve_result::Success, "Justinas" },
+        { "http://example.org/Person4", person::retrieve_result::NotFound, "" }
+    };
+
+    for (const auto& [uri, expected_result, expected_caption] : cases)
+    {
+        common::Person person(uri);
+
+        EXPECT_EQ(person::retrieve_person_name(person, ctx->world, ctx->model), expected_result)
+            << uri;
+        EXPECT_EQ(tools::to_comparable(person).caption, expected_caption) << uri;
+    }
+}
+
+} // namespace test::suite_retrieve_person_list
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 #include <variant>
 
 #include <gtest/gtest.h>
@@ -19,6 +21,8 @@
 #include "test/tools/person/comparable_note_factory.hpp"
 
 #include "common/comparators.hpp"
+#include "common/graph_traversal.hpp"
+#include "common/person.hpp"
 #include "person/error.hpp"
 #include "person/queries/details.hpp"
 
@@ -99,6 +103,26 @@ TEST_P(DetailsQueries_RetrievePersonPartners, NormalSuccessCases)
         ::testing::UnorderedElementsAreArray(tools::to_comparable(actual_notes)));
 };
 
+// The family graph lookup is expected to give the same results as the SPARQL query
+TEST_P(DetailsQueries_RetrievePersonPartners, NativeBackendSuccessCases)
+{
+    const Param& param = GetParam();
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / param.data_file);
+
+    const auto proband = std::make_shared<common::Person>(param.proband_uri);
+    std::vector<common::Note> actual_notes;
+
+    const auto actual_partners = adapt(
+        person::retrieve_person_partners(
+            proband.get(), ctx->world, ctx->model, actual_notes, person::query_backend::native));
+
+    EXPECT_THAT(param.expected_partners, ::testing::UnorderedElementsAreArray(actual_partners));
+    EXPECT_THAT(
+        param.expected_notes,
+        ::testing::UnorderedElementsAreArray(tools::to_comparable(actual_notes)));
+};
+
 /**
  * @brief Suite of single couple test cases
  *
@@ -1068,6 +1092,52 @@ TEST_P(DetailsQueries_RetrievePersonParents, NormalSuccessCases)
     EXPECT_EQ(param.expected_mother_notes, tools::to_comparable(actual_mother_notes));
 };
 
+// The family graph lookup is expected to give the same results as the SPARQL query
+TEST_P(DetailsQueries_RetrievePersonParents, NativeBackendSuccessCases)
+{
+    const Param& param = GetParam();
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / param.data_file);
+
+    const auto proband = std::make_shared<common::Person>(param.proband_uri);
+
+    // Both lookups share the graph built once (as the details command does)
+    const person::family_graph graph = person::build_family_graph(ctx->world, ctx->model);
+
+    std::vector<common::Note> actual_father_notes;
+    std::vector<common::Note> actual_mother_notes;
+
+    const auto& actual_father = person::retrieve_person_father(
+        proband.get(), ctx->world, ctx->model, actual_father_notes, person::query_backend::native,
+        nullptr, &graph);
+
+    const auto& actual_mother = person::retrieve_person_mother(
+        proband.get(), ctx->world, ctx->model, actual_mother_notes, person::query_backend::native,
+        nullptr, &graph);
+
+    if (param.expected_father.has_value())
+    {
+        EXPECT_EQ(param.expected_father.value(), *actual_father);
+    }
+    else
+    {
+        EXPECT_EQ(nullptr, actual_father.get());
+    }
+
+    EXPECT_EQ(param.expected_father_notes, tools::to_comparable(actual_father_notes));
+
+    if (param.expected_mother.has_value())
+    {
+        EXPECT_EQ(param.expected_mother.value(), *actual_mother);
+    }
+    else
+    {
+        EXPECT_EQ(nullptr, actual_mother.get());
+    }
+
+    EXPECT_EQ(param.expected_mother_notes, tools::to_comparable(actual_mother_notes));
+};
+
 const std::vector<Param> g_params {
     {
         .case_name="NoParents",
@@ -1469,4 +1539,125 @@ TEST_F(DetailsQueries_RetrievePersonParents, InputContractViolations)
 
 } // namespace suite2
 
+//  The retrieve_person_relatives function tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace suite_retrieve_person_relatives
+{
+
+struct Param
+{
+    const char* case_name;
+    std::string model_path;
+};
+
+class DetailsQueries_RetrievePersonRelatives : public ::testing::TestWithParam<Param> {};
+
+std::string retrieve_relatives_json(
+    const std::string& person_uri, librdf_world* world, librdf_model* model,
+    const person::relatives_query_options& options)
+{
+    std::shared_ptr<common::Person> proband =
+        person::retrieve_person_base_data_req(person_uri, world, model);
+    person::retrieve_person_name(*proband, world, model);
+    person::retrieve_person_relatives(*proband, world, model, options);
+
+    return common::person_to_json(*proband).dump(4);
+}
+
+// The lookups sharing the family graph of the run are expected to give the byte identical output
+//  as the lookups building their own graphs
+TEST_P(DetailsQueries_RetrievePersonRelatives, SharedGraphMatchesLocalGraphs)
+{
+    const Param& param = GetParam();
+
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / param.model_path);
+
+    const person::family_graph graph = person::build_family_graph(ctx->world, ctx->model);
+
+    for (const std::shared_ptr<common::Resource>& resource :
+             person::retrieve_person_uris(ctx->world, ctx->model))
+    {
+        const std::string expected_json = retrieve_relatives_json(
+            resource->get_uri_str(), ctx->world, ctx->model,
+            { .backend = person::query_backend::native, .graph = nullptr });
+        const std::string actual_json = retrieve_relatives_json(
+            resource->get_uri_str(), ctx->world, ctx->model,
+            { .backend = person::query_backend::native, .graph = &graph });
+
+        EXPECT_EQ(expected_json, actual_json) << resource->get_uri_str();
+    }
+}
+
+// The lookups spread over the pool contexts are expected to give the byte identical output as the
+//  sequential ones (the pool is reused by all the probands, the same as by the details command)
+TEST_P(DetailsQueries_RetrievePersonRelatives, PooledMatchesSequential)
+{
+    const Param& param = GetParam();
+
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / param.model_path);
+
+    const common::rdf_triple_buffer triples = common::find_triples(ctx->world, ctx->model, {});
+
+    for (const person::query_backend backend :
+             { person::query_backend::sparql, person::query_backend::native })
+    {
+        for (std::size_t context_count = 1;
+             context_count <= person::relatives_lookup_pool::k_max_context_count; ++context_count)
+        {
+            person::relatives_lookup_pool pool(context_count, common::storage_backend::memory);
+            pool.fill(triples);
+
+            for (const std::shared_ptr<common::Resource>& resource :
+                     person::retrieve_person_uris(ctx->world, ctx->model))
+            {
+                const std::string expected_json = retrieve_relatives_json(
+                    resource->get_uri_str(), ctx->world, ctx->model, { .backend = backend });
+                const std::string actual_json = retrieve_relatives_json(
+                    resource->get_uri_str(), ctx->world, ctx->model,
+                    { .backend = backend, .graph = nullptr, .pool = &pool });
+
+                EXPECT_EQ(expected_json, actual_json)
+                    << resource->get_uri_str() << " (" << context_count << " contexts)";
+            }
+        }
+    }
+}
+
+const std::vector<Param> g_params{
+    {
+        .case_name="SomeInferredPartners",
+        .model_path=(
+            "data/queries/details/retrieve_person_partners/"
+            "model-05_three-generations-some-inferred.ttl")
+    },
+    {
+        .case_name="ThreeCouples",
+        .model_path="data/queries/details/retrieve_person_partners/model-07_three-couples.ttl"
+    },
+    {
+        .case_name="TwoFamilies",
+        .model_path=(
+            "data/queries/details/retrieve_person_parent/"
+            "model-04_two-families-three-generations.ttl")
+    },
+    {
+        .case_name="MultipleParents",
+        .model_path=(
+            "data/queries/details/retrieve_person_parent/"
+            "model-05_multiple-resources-found.ttl")
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    DetailsQueries_RetrievePersonRelatives,
+    ::testing::ValuesIn(g_params),
+    tools::ParamNameGen<Param>);
+
+} // namespace suite_retrieve_person_relatives
+
 } // namespace test
+
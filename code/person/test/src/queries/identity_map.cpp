@@ -0,0 +1,120 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/tools/application.hpp"
+#include "test/tools/assertions.hpp"
+#include "test/tools/redland.hpp"
+
+#include "person/error.hpp"
+#include "person/queries/details.hpp"
+#include "person/queries/identity_map.hpp"
+
+//  The person_identity_map class tests
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - //
+
+namespace test::suite_person_identity_map
+{
+
+namespace
+{
+
+constexpr const char* k_data_file =
+    "data/queries/common/retrieve_person_caption_data/model-01_normal-success-cases.ttl";
+
+} // anonymous namespace
+
+TEST(IdentityMap_GetBaseData, ReturnsSameObject)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / k_data_file);
+
+    person::person_identity_map persons(ctx->world, ctx->model);
+
+    const auto first = persons.get_base_data_req("http://example.org/Person1");
+    const auto second = persons.get_base_data_req("http://example.org/Person1");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->get_caption(), "Petrauskaitė, Ugnė");
+    EXPECT_EQ(first->gender, common::Gender::Female);
+    EXPECT_EQ(persons.size(), 1);
+}
+
+TEST(IdentityMap_GetBaseData, UpgradesCaptionData)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / k_data_file);
+
+    person::person_identity_map persons(ctx->world, ctx->model);
+
+    const auto caption = persons.get_caption_data_req("http://example.org/Person2");
+
+    EXPECT_EQ(caption->get_caption(), "Navickas, Domantas");
+    EXPECT_FALSE(caption->gender.has_value());
+
+    const auto base = persons.get_base_data_req("http://example.org/Person2");
+
+    EXPECT_EQ(caption, base);
+    EXPECT_EQ(caption->gender, common::Gender::Male);
+
+    // The base data entry satisfies the subsequent caption data requests
+    EXPECT_EQ(persons.get_caption_data_req("http://example.org/Person2"), base);
+}
+
+TEST(IdentityMap_GetBaseData, MissingPerson)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(ctx->world, ctx->model, tools::get_program_path() / k_data_file);
+
+    person::person_identity_map persons(ctx->world, ctx->model);
+
+    EXPECT_EQ(persons.get_base_data_opt("http://example.org/Missing"), nullptr);
+    EXPECT_EQ(persons.get_caption_data_opt("http://example.org/Missing"), nullptr);
+
+    EXPECT_THROW_WITH_CODE(
+        persons.get_base_data_req("http://example.org/Missing"),
+        person::person_exception, person::person_exception::error_code::resource_not_found);
+
+    EXPECT_THROW_WITH_CODE(
+        persons.get_caption_data_seq_req(
+            { "http://example.org/Person1", "http://example.org/Missing" }),
+        person::person_exception, person::person_exception::error_code::resource_not_found);
+}
+
+TEST(IdentityMap_Construct, InputContractViolations)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+
+    EXPECT_THROW_WITH_CODE(
+        person::person_identity_map(nullptr, ctx->model),
+        person::person_exception, person::person_exception::error_code::input_contract_error);
+
+    EXPECT_THROW_WITH_CODE(
+        person::person_identity_map(ctx->world, nullptr),
+        person::person_exception, person::person_exception::error_code::input_contract_error);
+}
+
+// The relatives retrieved with a shared identity map are the same objects
+TEST(IdentityMap_Details, SharedRelatives)
+{
+    tools::scoped_redland_ctx ctx = tools::initialize_redland_ctx();
+    tools::load_rdf(
+        ctx->world, ctx->model,
+        tools::get_program_path() /
+        "data/queries/details/retrieve_person_parent/model-03_both-parents.ttl");
+
+    person::person_identity_map persons(ctx->world, ctx->model);
+    const auto proband = std::make_shared<common::Person>("http://example.org/P1");
+    std::vector<common::Note> notes;
+
+    const auto father = person::retrieve_person_father(
+        proband.get(), ctx->world, ctx->model, notes, person::query_backend::sparql, &persons);
+
+    ASSERT_NE(father, nullptr);
+    EXPECT_EQ(father, persons.get_base_data_req("http://example.org/P2"));
+    EXPECT_EQ(persons.size(), 1);
+}
+
+} // namespace test::suite_person_identity_map